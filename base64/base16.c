@@ -0,0 +1,230 @@
+/**
+ * Copyright (c) 2020-2026, Haier
+ *
+ * base16 (hex) codec.
+ *
+ * base16即十六进制编码（RFC 4648），每个字节拆成高低两个4位，分别对应 0123456789ABCDEF 中的一个字符，
+ * 编码后的数据为原来的2倍。
+ *
+ * 每个字节的编码互相独立，适合用SIMD一次处理多个字节：支持SSE2时每次处理16字节原始数据（32字符），
+ * 剩余部分使用查找表逐字节处理。
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#include "base16.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*--- Defines/Macros/Types -------------------------------------------------------------------------*/
+
+
+/*--- Prototypes -----------------------------------------------------------------------------------*/
+
+#if defined(__SSE2__)
+static size_t base16_encode_sse2(const uint8_t *raw_data, size_t raw_data_len, char *base16_buf);
+static size_t base16_decode_sse2(const char *base16, size_t base16_len, uint8_t *raw_data_buf);
+#endif
+
+
+/*--- Variables ------------------------------------------------------------------------------------*/
+
+
+/*--- Constants ------------------------------------------------------------------------------------*/
+
+/* base16编码查找表 */
+static const char base16_encode_lut[16] = "0123456789ABCDEF";
+
+/* base16解码查找表，大小写均可 */
+static const uint8_t base16_decode_lut[256] = 
+{
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x00 ~ 0x07 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x08 ~ 0x0f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x10 ~ 0x17 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x18 ~ 0x1f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x20 ~ 0x27 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x28 ~ 0x2f */
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,     /* ASCII: 0x30 ~ 0x37 */
+    0x08, 0x09, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x38 ~ 0x3f */
+    0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff,     /* ASCII: 0x40 ~ 0x47 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x48 ~ 0x4f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x50 ~ 0x57 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x58 ~ 0x5f */
+    0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff,     /* ASCII: 0x60 ~ 0x67 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x68 ~ 0x6f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x70 ~ 0x77 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x78 ~ 0x7f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x80 ~ 0x87 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x88 ~ 0x8f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x90 ~ 0x97 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x98 ~ 0x9f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xa0 ~ 0xa7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xa8 ~ 0xaf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xb0 ~ 0xb7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xb8 ~ 0xbf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xc0 ~ 0xc7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xc8 ~ 0xcf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xd0 ~ 0xd7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xd8 ~ 0xdf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xe0 ~ 0xe7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xe8 ~ 0xef */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xf0 ~ 0xf7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xf8 ~ 0xff */
+};
+
+
+/*--- Global Function Implementation ---------------------------------------------------------------*/
+
+char *base16_encode(const void *_raw_data, size_t raw_data_len, char *base16_buf, size_t base16_buf_len)
+{
+    const uint8_t * const raw_data = _raw_data;
+
+    size_t i = 0;
+
+    /* 检查参数合法性 */
+    if (raw_data == NULL || base16_buf == NULL)
+        return NULL;
+    if (base16_buf_len < calc_base16_buf_size(raw_data_len))
+        return NULL;
+
+#if defined(__SSE2__)
+    i = base16_encode_sse2(raw_data, raw_data_len, base16_buf);
+#endif
+
+    /* 剩余字节逐个处理 */
+    for (; i < raw_data_len; i++)
+    {
+        base16_buf[i * 2] = base16_encode_lut[raw_data[i] >> 4];
+        base16_buf[i * 2 + 1] = base16_encode_lut[raw_data[i] & 0x0f];
+    }
+
+    base16_buf[raw_data_len * 2] = '\0';
+    return base16_buf;
+}
+
+int base16_decode(const char *base16, void *_raw_data_buf, size_t raw_data_buf_len)
+{
+    uint8_t * const raw_data_buf = _raw_data_buf;
+
+    size_t i = 0;
+    size_t base16_len;
+    uint8_t hi, lo;
+
+    /* 检查参数合法性 */
+    if (base16 == NULL || raw_data_buf == NULL)
+        return -1;
+    if (base16[0] == '\0')
+        return 0;
+    base16_len = strlen(base16) / 2 * 2;    /* 截断到合法长度，与base64_decode()保持一致 */
+    if (base16_len == 0)
+        return -1;
+    if (raw_data_buf_len < calc_base16_raw_data_buf_size(base16_len))
+        return -1;
+
+#if defined(__SSE2__)
+    i = base16_decode_sse2(base16, base16_len, raw_data_buf);
+#endif
+
+    /* 剩余字符每2个为一组处理，遇到无效编码时停止 */
+    for (; i < base16_len; i += 2)
+    {
+        hi = base16_decode_lut[(uint8_t)base16[i]];
+        lo = base16_decode_lut[(uint8_t)base16[i + 1]];
+        if (hi == 0xff || lo == 0xff)
+            break;
+        raw_data_buf[i / 2] = (uint8_t)((hi << 4) | lo);
+    }
+
+    return i / 2;
+}
+
+
+/*--- Local Function Implementation ----------------------------------------------------------------*/
+
+#if defined(__SSE2__)
+/**
+ * @brief 将16个4位数值转换为base16字符
+ */
+static inline __m128i base16_nibble_to_ascii(__m128i nibble)
+{
+    /* 0~9 -> '0'~'9'，10~15 -> 'A'~'F'（'A' - '0' - 10 = 7） */
+    __m128i above9 = _mm_and_si128(_mm_cmpgt_epi8(nibble, _mm_set1_epi8(9)), _mm_set1_epi8(7));
+    return _mm_add_epi8(_mm_add_epi8(nibble, _mm_set1_epi8('0')), above9);
+}
+
+/**
+ * @brief SSE2编码，每次处理16字节
+ * 
+ * @return 已处理的原始数据长度
+ */
+static size_t base16_encode_sse2(const uint8_t *raw_data, size_t raw_data_len, char *base16_buf)
+{
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    size_t i;
+
+    for (i = 0; i + 16 <= raw_data_len; i += 16)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(raw_data + i));
+        __m128i hi = base16_nibble_to_ascii(_mm_and_si128(_mm_srli_epi16(x, 4), mask));
+        __m128i lo = base16_nibble_to_ascii(_mm_and_si128(x, mask));
+
+        /* 高4位字符在前，低4位字符在后 */
+        _mm_storeu_si128((__m128i *)(base16_buf + i * 2), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(base16_buf + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+
+    return i;
+}
+
+/**
+ * @brief 将16个base16字符转换为4位数值
+ * 
+ * @param valid 输出全部字符是否有效
+ */
+static inline __m128i base16_ascii_to_nibble(__m128i c, int *valid)
+{
+    /* 无符号比较：x <= n 等价于 min(x, n) == x */
+    __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    __m128i alpha = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+
+    *valid = _mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) == 0xffff;
+
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+                        _mm_andnot_si128(is_digit, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+/**
+ * @brief SSE2解码，每次处理32字符，遇到无效字符时交给逐字符处理
+ * 
+ * @return 已处理的base16字符串长度
+ */
+static size_t base16_decode_sse2(const char *base16, size_t base16_len, uint8_t *raw_data_buf)
+{
+    const __m128i mask = _mm_set1_epi16(0x00f0);
+    size_t i;
+    int valid_a, valid_b;
+
+    for (i = 0; i + 32 <= base16_len; i += 32)
+    {
+        __m128i a = base16_ascii_to_nibble(_mm_loadu_si128((const __m128i *)(base16 + i)), &valid_a);
+        __m128i b = base16_ascii_to_nibble(_mm_loadu_si128((const __m128i *)(base16 + i + 16)), &valid_b);
+        if (!valid_a || !valid_b)
+            break;
+
+        /* 每16位中低字节为高4位，高字节为低4位，合并为一个字节 */
+        a = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(a, 4), mask), _mm_srli_epi16(a, 8));
+        b = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(b, 4), mask), _mm_srli_epi16(b, 8));
+        _mm_storeu_si128((__m128i *)(raw_data_buf + i / 2), _mm_packus_epi16(a, b));
+    }
+
+    return i;
+}
+#endif
@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2020-2026, Haier
+ *
+ * base16 (hex) codec.
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#ifndef BASE16_H
+#define BASE16_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--- Defines/Macros/Types -------------------------------------------------------------------------*/
+
+/* 由base16字符串长度计算原始数据缓冲区长度 */
+#define calc_base16_raw_data_buf_size(base16_size)  ((base16_size) / 2)
+
+/* 由原始数据长度计算base16缓冲区长度 */
+#define calc_base16_buf_size(raw_data_size)         ((raw_data_size) * 2 + 1)
+
+
+/*--- Global Variables -----------------------------------------------------------------------------*/
+
+
+/*--- Global Constants -----------------------------------------------------------------------------*/
+
+
+/*--- Global Prototypes ----------------------------------------------------------------------------*/
+
+/**
+ * @brief base16编码（大写字母）
+ *
+ * @param _raw_data 待编码的原始数据
+ * @param raw_data_len 原始数据长度
+ * @param base16_buf base16缓冲区指针
+ * @param base16_buf_len base16缓冲区长度
+ * @return 成功返回编码后的字符串指针，失败返回NULL
+ */
+char *base16_encode(const void *_raw_data, size_t raw_data_len, char *base16_buf, size_t base16_buf_len);
+
+/**
+ * @brief base16解码（大小写均可）
+ *
+ * @param base16 待解码的base16字符串
+ * @param _raw_data_buf 原始数据缓冲区指针
+ * @param raw_data_buf_len 原始数据缓冲区长度
+ * @return 成功返回解码后的原始数据长度，失败返回<0
+ */
+int base16_decode(const char *base16, void *_raw_data_buf, size_t raw_data_buf_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BASE16_H */
@@ -0,0 +1,259 @@
+/**
+ * Copyright (c) 2020-2026, Haier
+ *
+ * base32 codec.
+ *
+ * base32（RFC 4648）每5位对应一个可打印字符，5个字节共40位，对应8个base32字符，编码后的数据为原来的8/5。
+ * 数据不足5个字节时剩余位用0补足，并在结尾用“=”补齐到8个字符。
+ * 标准字母表为 A-Z2-7；扩展十六进制字母表（base32hex）为 0-9A-V，编码结果保持原始数据的排序顺序。
+ *
+ * 实现上每组5字节先拼成一个64位整数再拆分，避免逐位移动。
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#include "base32.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/*--- Defines/Macros/Types -------------------------------------------------------------------------*/
+
+
+/*--- Prototypes -----------------------------------------------------------------------------------*/
+
+static char *base32_encode_common(const uint8_t *raw_data, size_t raw_data_len, char *base32_buf, size_t base32_buf_len,
+                                  const char *encode_lut);
+static int base32_decode_common(const char *base32, uint8_t *raw_data_buf, size_t raw_data_buf_len,
+                                const uint8_t *decode_lut);
+
+
+/*--- Variables ------------------------------------------------------------------------------------*/
+
+
+/*--- Constants ------------------------------------------------------------------------------------*/
+
+/* base32编码查找表 */
+static const char base32_encode_lut[32] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+static const char base32hex_encode_lut[32] = "0123456789ABCDEFGHIJKLMNOPQRSTUV";
+
+/* base32解码查找表，大小写均可 */
+static const uint8_t base32_decode_lut[256] = 
+{
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x00 ~ 0x07 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x08 ~ 0x0f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x10 ~ 0x17 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x18 ~ 0x1f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x20 ~ 0x27 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x28 ~ 0x2f */
+    0xff, 0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,     /* ASCII: 0x30 ~ 0x37 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x38 ~ 0x3f */
+    0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,     /* ASCII: 0x40 ~ 0x47 */
+    0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,     /* ASCII: 0x48 ~ 0x4f */
+    0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,     /* ASCII: 0x50 ~ 0x57 */
+    0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x58 ~ 0x5f */
+    0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,     /* ASCII: 0x60 ~ 0x67 */
+    0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,     /* ASCII: 0x68 ~ 0x6f */
+    0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,     /* ASCII: 0x70 ~ 0x77 */
+    0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x78 ~ 0x7f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x80 ~ 0x87 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x88 ~ 0x8f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x90 ~ 0x97 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x98 ~ 0x9f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xa0 ~ 0xa7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xa8 ~ 0xaf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xb0 ~ 0xb7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xb8 ~ 0xbf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xc0 ~ 0xc7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xc8 ~ 0xcf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xd0 ~ 0xd7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xd8 ~ 0xdf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xe0 ~ 0xe7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xe8 ~ 0xef */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xf0 ~ 0xf7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xf8 ~ 0xff */
+};
+
+/* base32hex解码查找表，大小写均可 */
+static const uint8_t base32hex_decode_lut[256] = 
+{
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x00 ~ 0x07 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x08 ~ 0x0f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x10 ~ 0x17 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x18 ~ 0x1f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x20 ~ 0x27 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x28 ~ 0x2f */
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,     /* ASCII: 0x30 ~ 0x37 */
+    0x08, 0x09, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x38 ~ 0x3f */
+    0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,     /* ASCII: 0x40 ~ 0x47 */
+    0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,     /* ASCII: 0x48 ~ 0x4f */
+    0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0xff,     /* ASCII: 0x50 ~ 0x57 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x58 ~ 0x5f */
+    0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,     /* ASCII: 0x60 ~ 0x67 */
+    0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,     /* ASCII: 0x68 ~ 0x6f */
+    0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0xff,     /* ASCII: 0x70 ~ 0x77 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x78 ~ 0x7f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x80 ~ 0x87 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x88 ~ 0x8f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x90 ~ 0x97 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x98 ~ 0x9f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xa0 ~ 0xa7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xa8 ~ 0xaf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xb0 ~ 0xb7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xb8 ~ 0xbf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xc0 ~ 0xc7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xc8 ~ 0xcf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xd0 ~ 0xd7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xd8 ~ 0xdf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xe0 ~ 0xe7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xe8 ~ 0xef */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xf0 ~ 0xf7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xf8 ~ 0xff */
+};
+
+/* 末组填充符个数对应的原始数据字节数，-1表示非法填充 */
+static const int8_t base32_pad_to_bytes[8] = { 5, 4, -1, 3, 2, -1, 1, -1 };
+
+
+/*--- Global Function Implementation ---------------------------------------------------------------*/
+
+char *base32_encode(const void *_raw_data, size_t raw_data_len, char *base32_buf, size_t base32_buf_len)
+{
+    return base32_encode_common(_raw_data, raw_data_len, base32_buf, base32_buf_len, base32_encode_lut);
+}
+
+int base32_decode(const char *base32, void *_raw_data_buf, size_t raw_data_buf_len)
+{
+    return base32_decode_common(base32, _raw_data_buf, raw_data_buf_len, base32_decode_lut);
+}
+
+char *base32hex_encode(const void *_raw_data, size_t raw_data_len, char *base32_buf, size_t base32_buf_len)
+{
+    return base32_encode_common(_raw_data, raw_data_len, base32_buf, base32_buf_len, base32hex_encode_lut);
+}
+
+int base32hex_decode(const char *base32, void *_raw_data_buf, size_t raw_data_buf_len)
+{
+    return base32_decode_common(base32, _raw_data_buf, raw_data_buf_len, base32hex_decode_lut);
+}
+
+
+/*--- Local Function Implementation ----------------------------------------------------------------*/
+
+static char *base32_encode_common(const uint8_t *raw_data, size_t raw_data_len, char *base32_buf, size_t base32_buf_len,
+                                  const char *encode_lut)
+{
+    size_t i, j;
+    size_t remain;
+    size_t chars;
+    uint64_t value;
+    int k;
+
+    /* 检查参数合法性 */
+    if (raw_data == NULL || base32_buf == NULL)
+        return NULL;
+    if (base32_buf_len < calc_base32_buf_size(raw_data_len))
+        return NULL;
+
+    /* 每5个字节为一组进行处理 */
+    for (i = 0, j = 0; i + 5 <= raw_data_len; i += 5, j += 8)
+    {
+        value = ((uint64_t)raw_data[i] << 32) | ((uint64_t)raw_data[i + 1] << 24) | ((uint64_t)raw_data[i + 2] << 16)
+              | ((uint64_t)raw_data[i + 3] << 8) | raw_data[i + 4];
+
+        base32_buf[j] = encode_lut[(value >> 35) & 0x1f];
+        base32_buf[j + 1] = encode_lut[(value >> 30) & 0x1f];
+        base32_buf[j + 2] = encode_lut[(value >> 25) & 0x1f];
+        base32_buf[j + 3] = encode_lut[(value >> 20) & 0x1f];
+        base32_buf[j + 4] = encode_lut[(value >> 15) & 0x1f];
+        base32_buf[j + 5] = encode_lut[(value >> 10) & 0x1f];
+        base32_buf[j + 6] = encode_lut[(value >> 5) & 0x1f];
+        base32_buf[j + 7] = encode_lut[value & 0x1f];
+    }
+
+    /* 处理剩余不足5个字节的数据 */
+    remain = raw_data_len - i;
+    if (remain > 0)
+    {
+        value = 0;
+        for (k = 0; k < (int)remain; k++)
+            value |= (uint64_t)raw_data[i + k] << (32 - k * 8);
+
+        chars = (remain * 8 + 4) / 5;       /* 有效字符数 */
+        for (k = 0; k < 8; k++)
+            base32_buf[j + k] = (k < (int)chars) ? encode_lut[(value >> (35 - k * 5)) & 0x1f] : '=';
+        j += 8;
+    }
+
+    base32_buf[j] = '\0';
+    return base32_buf;
+}
+
+static int base32_decode_common(const char *base32, uint8_t *raw_data_buf, size_t raw_data_buf_len,
+                                const uint8_t *decode_lut)
+{
+    size_t i, j;
+    size_t base32_len;
+    size_t raw_data_len;
+    uint64_t value;
+    uint8_t temp;
+    int pad;
+    int bytes;
+    int k;
+
+    /* 检查参数合法性 */
+    if (base32 == NULL || raw_data_buf == NULL)
+        return -1;
+    if (base32[0] == '\0')
+        return 0;
+    base32_len = strlen(base32) / 8 * 8;    /* 截断到合法长度，与base64_decode()保持一致 */
+    if (base32_len == 0)
+        return -1;
+
+    /* 计算原始数据长度 */
+    for (pad = 0; pad < 7 && base32[base32_len - 1 - pad] == '='; pad++);
+    if (base32_pad_to_bytes[pad] < 0)
+        return -1;
+    raw_data_len = (base32_len / 8 - 1) * 5 + base32_pad_to_bytes[pad];
+    if (raw_data_buf_len < raw_data_len)
+        return -1;
+
+    /* 每8个字符为一组进行处理 */
+    for (i = 0, j = 0; i < base32_len; i += 8)
+    {
+        value = 0;
+        for (k = 0; k < 8; k++)
+        {
+            temp = decode_lut[(uint8_t)base32[i + k]];
+            if (temp == 0xff)
+                break;
+            value = (value << 5) | temp;
+        }
+
+        if (k < 8)
+        {
+            /* 仅允许末尾为合法个数的填充符 */
+            for (pad = k; pad < 8 && base32[i + pad] == '='; pad++);
+            if (k == 0 || pad != 8 || base32_pad_to_bytes[8 - k] < 0)
+                break;      /* 无效编码 */
+            value <<= (8 - k) * 5;
+        }
+
+        bytes = base32_pad_to_bytes[8 - k];
+        raw_data_buf[j++] = (uint8_t)(value >> 32);
+        if (bytes > 1)
+            raw_data_buf[j++] = (uint8_t)(value >> 24);
+        if (bytes > 2)
+            raw_data_buf[j++] = (uint8_t)(value >> 16);
+        if (bytes > 3)
+            raw_data_buf[j++] = (uint8_t)(value >> 8);
+        if (bytes > 4)
+            raw_data_buf[j++] = (uint8_t)value;
+        if (k < 8)
+            break;
+    }
+
+    return j;
+}
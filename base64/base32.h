@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2020-2026, Haier
+ *
+ * base32 codec.
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#ifndef BASE32_H
+#define BASE32_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--- Defines/Macros/Types -------------------------------------------------------------------------*/
+
+/* 由base32字符串长度估算原始数据缓冲区长度 */
+#define calc_base32_raw_data_buf_size(base32_size)  ((base32_size) / 8 * 5)
+
+/* 由原始数据长度计算base32缓冲区长度 */
+#define calc_base32_buf_size(raw_data_size)         (((raw_data_size) + 4) / 5 * 8 + 1)
+
+
+/*--- Global Variables -----------------------------------------------------------------------------*/
+
+
+/*--- Global Constants -----------------------------------------------------------------------------*/
+
+
+/*--- Global Prototypes ----------------------------------------------------------------------------*/
+
+/**
+ * @brief base32编码（RFC 4648标准字母表 A-Z2-7）
+ *
+ * @param _raw_data 待编码的原始数据
+ * @param raw_data_len 原始数据长度
+ * @param base32_buf base32缓冲区指针
+ * @param base32_buf_len base32缓冲区长度
+ * @return 成功返回编码后的字符串指针，失败返回NULL
+ */
+char *base32_encode(const void *_raw_data, size_t raw_data_len, char *base32_buf, size_t base32_buf_len);
+
+/**
+ * @brief base32解码（RFC 4648标准字母表，大小写均可）
+ *
+ * @param base32 待解码的base32字符串
+ * @param _raw_data_buf 原始数据缓冲区指针
+ * @param raw_data_buf_len 原始数据缓冲区长度
+ * @return 成功返回解码后的原始数据长度，失败返回<0
+ */
+int base32_decode(const char *base32, void *_raw_data_buf, size_t raw_data_buf_len);
+
+/**
+ * @brief base32hex编码（RFC 4648扩展十六进制字母表 0-9A-V，保持排序顺序）
+ *
+ * 参数及返回值同base32_encode()
+ */
+char *base32hex_encode(const void *_raw_data, size_t raw_data_len, char *base32_buf, size_t base32_buf_len);
+
+/**
+ * @brief base32hex解码（大小写均可）
+ *
+ * 参数及返回值同base32_decode()
+ */
+int base32hex_decode(const char *base32, void *_raw_data_buf, size_t raw_data_buf_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BASE32_H */
@@ -25,12 +25,48 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <string.h>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
 
 /*--- Defines/Macros/Types -------------------------------------------------------------------------*/
 
+#if defined(__SSSE3__)
+/* 批量编解码暂存区大小（原始数据字节数或base64字符数）及最大条数 */
+#define BASE64_BATCH_STAGE_SIZE         2048
+#define BASE64_BATCH_STAGE_RECORDS      128
+
+/*
+ * 批量编解码暂存区：多条短数据的完整分组拼接成连续数据后按向量处理，一个向量可以跨越多条数据，
+ * 每条末尾不足一个向量的部分不再单独逐组处理，各条的结尾（编码时剩余的1~2字节，解码时可能含'='
+ * 的最后一组）在分发结果时逐条处理一次。
+ */
+typedef struct
+{
+    uint8_t in[BASE64_BATCH_STAGE_SIZE + 16];           /* 拼接后的数据，末尾留出向量读取的余量 */
+    uint8_t out[BASE64_BATCH_STAGE_SIZE / 3 * 4 + 16];  /* 向量处理结果，末尾留出向量写入的余量 */
+    const void *records[BASE64_BATCH_STAGE_RECORDS];    /* 各条数据 */
+    size_t lens[BASE64_BATCH_STAGE_RECORDS];            /* 各条长度（解码时为可解码长度） */
+    size_t in_len;
+    size_t count;
+} base64_batch_stage_t;
+#endif
+
 
 /*--- Prototypes -----------------------------------------------------------------------------------*/
 
+static size_t base64_valid_len(size_t base64_len);
+static size_t base64_raw_data_len(const char *base64, size_t base64_len);
+static size_t base64_encode_data(const uint8_t *raw_data, size_t raw_data_len, char *base64_buf);
+static int base64_decode_data(const char *base64, size_t base64_len, uint8_t *raw_data_buf);
+#if defined(__SSSE3__)
+static void base64_copy(void *dst, const void *src, size_t len);
+static void base64_encode_blocks(const uint8_t *raw_data, size_t blocks, char *base64_buf);
+static size_t base64_decode_blocks(const char *base64, size_t blocks, uint8_t *raw_data_buf);
+static size_t base64_encode_stage_flush(base64_batch_stage_t *stage, char *base64_buf, size_t j, size_t *offsets);
+static size_t base64_decode_stage_flush(base64_batch_stage_t *stage, uint8_t *raw_data_buf, size_t j, size_t *offsets);
+#endif
+
 
 /*--- Variables ------------------------------------------------------------------------------------*/
 
@@ -84,8 +120,7 @@ char *base64_encode(const void *_raw_data, size_t raw_data_len, char *base64_buf
 {
     const uint8_t * const raw_data = _raw_data;
 
-    size_t i, j;
-    uint8_t current;
+    size_t j;
 
     /* 检查参数合法性 */
     if (raw_data == NULL || base64_buf == NULL)
@@ -93,42 +128,7 @@ char *base64_encode(const void *_raw_data, size_t raw_data_len, char *base64_buf
     if (base64_buf_len < calc_base64_buf_size(raw_data_len))
         return NULL;
 
-    /* 每3个字节为一组进行处理 */
-    for (i = 0, j = 0; i < raw_data_len; i += 3)
-    {
-        /* 处理第1个字节高6位 */
-        current = (raw_data[i] >> 2) & 0x3f;
-        base64_buf[j++] = base64_encode_lut[current];
-
-        /* 处理第1个字节低2位 */
-        current = (raw_data[i] << 4) & 0x30;
-        if (i + 1 >= raw_data_len)
-        {   /* 仅剩1字节 */
-            base64_buf[j++] = base64_encode_lut[current];
-            base64_buf[j++] = '=';
-            base64_buf[j++] = '=';
-            break;
-        }
-        /* 处理第2个字节高4位 */
-        current |= (raw_data[i + 1] >> 4) & 0x0f;
-        base64_buf[j++] = base64_encode_lut[current];
-
-        /* 处理第2个字节低4位 */
-        current = (raw_data[i + 1] << 2) & 0x3c;
-        if (i + 2 >= raw_data_len)
-        {   /* 仅剩2字节 */
-            base64_buf[j++] = base64_encode_lut[current];
-            base64_buf[j++] = '=';
-            break;
-        }
-        /* 处理第3个字节高2位 */
-        current |= (raw_data[i + 2] >> 6) & 0x03;
-        base64_buf[j++] = base64_encode_lut[current];
-
-        /* 处理第3个字节低6位 */
-        current = (raw_data[i + 2]) & (0x3f);
-        base64_buf[j++] = base64_encode_lut[current];
-    }
+    j = base64_encode_data(raw_data, raw_data_len, base64_buf);
 
     base64_buf[j] = '\0';
     return base64_buf;
@@ -138,8 +138,6 @@ int base64_decode(const char *base64, void *_raw_data_buf, size_t raw_data_buf_l
 {
     uint8_t * const raw_data_buf = _raw_data_buf;
 
-    size_t i, j;
-    uint8_t temp[4];
     size_t base64_len;
     size_t raw_data_len;
 
@@ -148,56 +146,351 @@ int base64_decode(const char *base64, void *_raw_data_buf, size_t raw_data_buf_l
         return -1;
     if (base64[0] == '\0')
         return 0;
-    base64_len = strlen(base64);
-    if (base64_len % 4 != 0)
-    {
+    base64_len = base64_valid_len(strlen(base64));
+    if (base64_len == 0)
+        return -1;
 #if 0
+    if (raw_data_buf_len < calc_raw_data_buf_size(base64_len))
+        return -1;
+#else
+    /* 计算原始数据长度 */
+    raw_data_len = base64_raw_data_len(base64, base64_len);
+    if (raw_data_buf_len < raw_data_len)
         return -1;
+#endif
+
+    return base64_decode_data(base64, base64_len, raw_data_buf);
+}
+
+int base64_decode_inplace(char *base64, size_t base64_buf_len)
+{
+    size_t base64_len;
+
+    /* 检查参数合法性 */
+    if (base64 == NULL)
+        return -1;
+    base64_len = strnlen(base64, base64_buf_len);
+    if (base64_len == 0)
+        return 0;
+    base64_len = base64_valid_len(base64_len);
+    if (base64_len == 0)
+        return -1;
+
+    /* 解码结果总是短于已读取的输入，从前向后覆盖不会破坏尚未读取的数据 */
+    return base64_decode_data(base64, base64_len, (uint8_t *)base64);
+}
+
+size_t calc_base64_batch_buf_size(const size_t *raw_data_lens, size_t count)
+{
+    size_t size = 0;
+    size_t i;
+
+    if (raw_data_lens == NULL)
+        return 0;
+
+    for (i = 0; i < count; i++)
+        size += calc_base64_buf_size(raw_data_lens[i]);
+
+    return size;
+}
+
+char *base64_encode_batch(const void * const *raw_data, const size_t *raw_data_lens, size_t count,
+                          char *base64_buf, size_t base64_buf_len, size_t *offsets)
+{
+    size_t i, j;
+    size_t base64_size = 0;
+
+    /* 检查参数合法性，整批只检查一次 */
+    if (raw_data == NULL || raw_data_lens == NULL || base64_buf == NULL || offsets == NULL)
+        return NULL;
+    for (i = 0; i < count; i++)
+    {
+        if (raw_data[i] == NULL)
+            return NULL;
+        base64_size += calc_base64_buf_size(raw_data_lens[i]);
+    }
+    if (base64_buf_len < base64_size)
+        return NULL;
+
+#if defined(__SSSE3__)
+    {
+        base64_batch_stage_t stage;
+        const uint8_t *raw;
+        size_t first = 0;
+        size_t blocks;
+        size_t len;
+
+        stage.in_len = 0;
+        stage.count = 0;
+        for (i = 0, j = 0; i < count; i++)
+        {
+            raw = raw_data[i];
+            len = raw_data_lens[i];
+            if (stage.count == BASE64_BATCH_STAGE_RECORDS || stage.in_len + len / 3 * 3 > BASE64_BATCH_STAGE_SIZE)
+            {
+                j = base64_encode_stage_flush(&stage, base64_buf, j, offsets + first);
+                first = i;
+            }
+
+            if (len / 3 * 3 > BASE64_BATCH_STAGE_SIZE)
+            {   /* 长数据直接按向量编码，最后一个向量之后保留4字节以免越界读取 */
+                offsets[i] = j;
+                blocks = (len - 4) / 12;
+                base64_encode_blocks(raw, blocks, base64_buf + j);
+                j += blocks * 16;
+                j += base64_encode_data(raw + blocks * 12, len - blocks * 12, base64_buf + j);
+                base64_buf[j++] = '\0';
+                first = i + 1;
+                continue;
+            }
+
+            base64_copy(stage.in + stage.in_len, raw, len / 3 * 3);
+            stage.in_len += len / 3 * 3;
+            stage.records[stage.count] = raw;
+            stage.lens[stage.count++] = len;
+        }
+        j = base64_encode_stage_flush(&stage, base64_buf, j, offsets + first);
+    }
 #else
-        base64_len = base64_len / 4 * 4;    /* 截断到合法长度，而非直接返回错误，提高鲁棒性 */
-        if (base64_len == 0)
+    /* 逐条编码到连续的输出缓冲区，每条以'\0'结尾 */
+    for (i = 0, j = 0; i < count; i++)
+    {
+        offsets[i] = j;
+        j += base64_encode_data(raw_data[i], raw_data_lens[i], base64_buf + j);
+        base64_buf[j++] = '\0';
+    }
+#endif
+    offsets[count] = j;
+
+    return base64_buf;
+}
+
+int base64_decode_batch(const char * const *base64, const size_t *base64_lens, size_t count,
+                        void *_raw_data_buf, size_t raw_data_buf_len, size_t *offsets)
+{
+    uint8_t * const raw_data_buf = _raw_data_buf;
+
+    size_t i, j;
+    size_t base64_len;
+    size_t raw_data_len;
+    size_t end;                 /* 已处理及暂存各条解码后的最大结束位置 */
+#if defined(__SSSE3__)
+    base64_batch_stage_t stage;
+    size_t first = 0;
+    size_t blocks;
+#endif
+
+    /* 检查参数合法性 */
+    if (base64 == NULL || raw_data_buf == NULL || offsets == NULL)
+        return -1;
+
+#if defined(__SSSE3__)
+    stage.in_len = 0;
+    stage.count = 0;
+#endif
+    /* 每条只求一次长度，边解码边检查缓冲区长度 */
+    for (i = 0, j = 0, end = 0; i < count; i++)
+    {
+        if (base64[i] == NULL)
             return -1;
+        base64_len = base64_lens ? base64_lens[i] : strlen(base64[i]);
+        if (base64_len != 0)
+        {
+            base64_len = base64_valid_len(base64_len);
+            if (base64_len == 0)
+                return -1;
+            raw_data_len = base64_raw_data_len(base64[i], base64_len);
+            if (raw_data_buf_len - end < raw_data_len)
+                return -1;
+            end += raw_data_len;
+        }
+
+#if defined(__SSSE3__)
+        /* 最后一组可能含'='，不放入暂存区 */
+        if (stage.count == BASE64_BATCH_STAGE_RECORDS
+            || (base64_len != 0 && stage.in_len + base64_len - 4 > BASE64_BATCH_STAGE_SIZE))
+        {
+            j = base64_decode_stage_flush(&stage, raw_data_buf, j, offsets + first);
+            first = i;
+        }
+
+        if (base64_len != 0 && base64_len - 4 > BASE64_BATCH_STAGE_SIZE)
+        {   /* 长数据直接按向量解码，最后一个向量之后至少保留8个字符，向量写入不会越过本条的解码结果 */
+            offsets[i] = j;
+            blocks = base64_decode_blocks(base64[i], (base64_len - 8) / 16, raw_data_buf + j);
+            j += blocks * 12;
+            j += base64_decode_data(base64[i] + blocks * 16, base64_len - blocks * 16, raw_data_buf + j);
+            end = j;
+            first = i + 1;
+            continue;
+        }
+
+        if (base64_len != 0)
+        {
+            base64_copy(stage.in + stage.in_len, base64[i], base64_len - 4);
+            stage.in_len += base64_len - 4;
+        }
+        stage.records[stage.count] = base64[i];
+        stage.lens[stage.count++] = base64_len;
+#else
+        offsets[i] = j;
+        j += base64_decode_data(base64[i], base64_len, raw_data_buf + j);
 #endif
     }
+#if defined(__SSSE3__)
+    j = base64_decode_stage_flush(&stage, raw_data_buf, j, offsets + first);
+#endif
+    offsets[count] = j;
+
+    return j;
+}
+
+
+/*--- Local Function Implementation ----------------------------------------------------------------*/
+
+/**
+ * @brief 计算可解码的base64字符串长度
+ * 
+ * @param base64_len base64字符串长度
+ * @return 可解码长度，不足一组时返回0
+ */
+static size_t base64_valid_len(size_t base64_len)
+{
 #if 0
-    if (raw_data_buf_len < calc_raw_data_buf_size(base64_len))
-        return -1;
+    if (base64_len % 4 != 0)
+        return 0;
+    return base64_len;
 #else
-    /* 计算原始数据长度 */
-    raw_data_len = base64_len / 4 * 3;
+    return base64_len / 4 * 4;      /* 截断到合法长度，而非直接返回错误，提高鲁棒性 */
+#endif
+}
+
+/**
+ * @brief 由base64字符串计算原始数据长度
+ * 
+ * @param base64 base64字符串
+ * @param base64_len base64字符串长度，应为4的倍数且不为0
+ * @return 原始数据长度
+ */
+static size_t base64_raw_data_len(const char *base64, size_t base64_len)
+{
+    size_t raw_data_len = base64_len / 4 * 3;
+
     if (base64[base64_len - 1] == '=')
     {
         raw_data_len--;
         if (base64[base64_len - 2] == '=')
             raw_data_len--;
     }
-    if (raw_data_buf_len < raw_data_len)
-        return -1;
-#endif
 
-    /* 每4个字符为一组进行处理 */
-    for (i = 0, j = 0; base64[i] != '\0'; i += 4)
+    return raw_data_len;
+}
+
+/**
+ * @brief base64编码核心处理，不检查参数，不写入'\0'
+ * 
+ * 完整的3字节组不含分支，剩余的1~2字节在循环外处理一次。
+ * 
+ * @param raw_data 待编码的原始数据
+ * @param raw_data_len 原始数据长度
+ * @param base64_buf base64缓冲区指针，长度由调用者保证
+ * @return 编码后的字符数
+ */
+static size_t base64_encode_data(const uint8_t *raw_data, size_t raw_data_len, char *base64_buf)
+{
+    size_t i, j;
+    uint32_t value;
+
+    /* 每3个字节为一组进行处理 */
+    for (i = 0, j = 0; i + 3 <= raw_data_len; i += 3, j += 4)
     {
-        temp[0] = base64_decode_lut[(int)base64[i]];
-        temp[1] = base64_decode_lut[(int)base64[i + 1]];
-        temp[2] = base64_decode_lut[(int)base64[i + 2]];
-        temp[3] = base64_decode_lut[(int)base64[i + 3]];
+        value = ((uint32_t)raw_data[i] << 16) | ((uint32_t)raw_data[i + 1] << 8) | raw_data[i + 2];
+        base64_buf[j] = base64_encode_lut[value >> 18];
+        base64_buf[j + 1] = base64_encode_lut[(value >> 12) & 0x3f];
+        base64_buf[j + 2] = base64_encode_lut[(value >> 6) & 0x3f];
+        base64_buf[j + 3] = base64_encode_lut[value & 0x3f];
+    }
+
+    if (raw_data_len - i == 1)
+    {   /* 仅剩1字节 */
+        value = (uint32_t)raw_data[i] << 16;
+        base64_buf[j++] = base64_encode_lut[value >> 18];
+        base64_buf[j++] = base64_encode_lut[(value >> 12) & 0x3f];
+        base64_buf[j++] = '=';
+        base64_buf[j++] = '=';
+    }
+    else if (raw_data_len - i == 2)
+    {   /* 仅剩2字节 */
+        value = ((uint32_t)raw_data[i] << 16) | ((uint32_t)raw_data[i + 1] << 8);
+        base64_buf[j++] = base64_encode_lut[value >> 18];
+        base64_buf[j++] = base64_encode_lut[(value >> 12) & 0x3f];
+        base64_buf[j++] = base64_encode_lut[(value >> 6) & 0x3f];
+        base64_buf[j++] = '=';
+    }
 
-        if ((temp[0] == 0xff && base64[i] != '=')
-            || (temp[1] == 0xff && base64[i + 1] != '=')
-            || (temp[2] == 0xff && base64[i + 2] != '=')
-            || (temp[3] == 0xff && base64[i + 3] != '='))
+    return j;
+}
+
+/**
+ * @brief base64解码核心处理
+ * 
+ * 每组4个字符先全部读出再写入3个字节，写入位置不会超过当前组的读取位置，
+ * 因此允许raw_data_buf与base64指向同一块缓冲区（原地解码）。
+ * 
+ * @param base64 待解码的base64字符串
+ * @param base64_len base64字符串长度，应为4的倍数
+ * @param raw_data_buf 原始数据缓冲区指针，长度由调用者保证
+ * @return 解码后的原始数据长度
+ */
+static int base64_decode_data(const char *base64, size_t base64_len, uint8_t *raw_data_buf)
+{
+    size_t i, j;
+    char c[4];
+    uint8_t temp[4];
+
+    /* 快速路径：最后一组之前的各组不应含'='，4个查表结果都有效（最高位为0）时直接输出 */
+    for (i = 0, j = 0; i + 4 < base64_len; i += 4, j += 3)
+    {
+        temp[0] = base64_decode_lut[(uint8_t)base64[i]];
+        temp[1] = base64_decode_lut[(uint8_t)base64[i + 1]];
+        temp[2] = base64_decode_lut[(uint8_t)base64[i + 2]];
+        temp[3] = base64_decode_lut[(uint8_t)base64[i + 3]];
+        if ((temp[0] | temp[1] | temp[2] | temp[3]) & 0x80)
+            break;      /* 交给下面逐组检查 */
+
+        raw_data_buf[j] = (uint8_t)((temp[0] << 2) | (temp[1] >> 4));
+        raw_data_buf[j + 1] = (uint8_t)((temp[1] << 4) | (temp[2] >> 2));
+        raw_data_buf[j + 2] = (uint8_t)((temp[2] << 6) | temp[3]);
+    }
+
+    /* 每4个字符为一组进行处理 */
+    for (; i < base64_len; i += 4)
+    {
+        c[0] = base64[i];
+        c[1] = base64[i + 1];
+        c[2] = base64[i + 2];
+        c[3] = base64[i + 3];
+
+        temp[0] = base64_decode_lut[(uint8_t)c[0]];
+        temp[1] = base64_decode_lut[(uint8_t)c[1]];
+        temp[2] = base64_decode_lut[(uint8_t)c[2]];
+        temp[3] = base64_decode_lut[(uint8_t)c[3]];
+
+        if ((temp[0] == 0xff && c[0] != '=')
+            || (temp[1] == 0xff && c[1] != '=')
+            || (temp[2] == 0xff && c[2] != '=')
+            || (temp[3] == 0xff && c[3] != '='))
         {
             /* 无效编码 */
             break;
         }
 
         raw_data_buf[j++] = (uint8_t)((temp[0] << 2) | (temp[1] >> 4));
-        if (base64[i + 2] == '=')
+        if (c[2] == '=')
             break;
 
         raw_data_buf[j++] = (uint8_t)((temp[1] << 4) | (temp[2] >> 2));
-        if (base64[i + 3] == '=')
+        if (c[3] == '=')
             break;
 
         raw_data_buf[j++] = (uint8_t)((temp[2] << 6) | temp[3]);
@@ -206,6 +499,213 @@ int base64_decode(const char *base64, void *_raw_data_buf, size_t raw_data_buf_l
     return j;
 }
 
+#if defined(__SSSE3__)
+/**
+ * @brief 短数据拷贝
+ * 
+ * 批量接口的每条数据通常只有几十字节，以首尾两段（可能重叠）的定长拷贝代替按长度调用memcpy()。
+ * 
+ * @param dst 目标地址
+ * @param src 源地址，不能与dst重叠
+ * @param len 长度
+ */
+static inline void base64_copy(void *dst, const void *src, size_t len)
+{
+    uint8_t *d = dst;
+    const uint8_t *s = src;
+    uint64_t head, tail;
 
-/*--- Local Function Implementation ----------------------------------------------------------------*/
+    if (len >= 16 && len <= 32)
+    {
+        __m128i v0 = _mm_loadu_si128((const __m128i *)s);
+        __m128i v1 = _mm_loadu_si128((const __m128i *)(s + len - 16));
+        _mm_storeu_si128((__m128i *)d, v0);
+        _mm_storeu_si128((__m128i *)(d + len - 16), v1);
+    }
+    else if (len > 32 && len <= 64)
+    {
+        __m128i v0 = _mm_loadu_si128((const __m128i *)s);
+        __m128i v1 = _mm_loadu_si128((const __m128i *)(s + 16));
+        __m128i v2 = _mm_loadu_si128((const __m128i *)(s + len - 32));
+        __m128i v3 = _mm_loadu_si128((const __m128i *)(s + len - 16));
+        _mm_storeu_si128((__m128i *)d, v0);
+        _mm_storeu_si128((__m128i *)(d + 16), v1);
+        _mm_storeu_si128((__m128i *)(d + len - 32), v2);
+        _mm_storeu_si128((__m128i *)(d + len - 16), v3);
+    }
+    else if (len >= 8 && len < 16)
+    {
+        memcpy(&head, s, 8);
+        memcpy(&tail, s + len - 8, 8);
+        memcpy(d, &head, 8);
+        memcpy(d + len - 8, &tail, 8);
+    }
+    else
+    {
+        memcpy(d, s, len);
+    }
+}
+
+/**
+ * @brief 向量编码，每组将12字节编码为16个字符
+ * 
+ * 每组读取16字节，调用者须保证最后一组之后仍有4字节可读。
+ * 
+ * @param raw_data 待编码的原始数据
+ * @param blocks 组数
+ * @param base64_buf base64缓冲区指针，长度由调用者保证
+ */
+static void base64_encode_blocks(const uint8_t *raw_data, size_t blocks, char *base64_buf)
+{
+    const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                          '/' - 63, 'A', 0, 0);
+    __m128i in, index, t0, t1, reduced;
+    size_t i;
+
+    for (i = 0; i < blocks; i++, raw_data += 12, base64_buf += 16)
+    {
+        /* 每个32位通道放入3个字节，再拆分为4个6位索引 */
+        in = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)raw_data), shuffle);
+        t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+        t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+        index = _mm_or_si128(t0, t1);
+
+        /* 索引按A-Z、a-z、0-9、'+'、'/'分段，查出各段的偏移量后与索引相加 */
+        reduced = _mm_subs_epu8(index, _mm_set1_epi8(51));
+        reduced = _mm_or_si128(reduced, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), index), _mm_set1_epi8(13)));
+        _mm_storeu_si128((__m128i *)base64_buf, _mm_add_epi8(index, _mm_shuffle_epi8(offsets, reduced)));
+    }
+}
+
+/**
+ * @brief 向量解码，每组将16个字符解码为12字节
+ * 
+ * 每组写入16字节，调用者须保证最后一组之后仍有4字节可写。遇到非base64字符（包括'='）的组时停止，
+ * 该组不写入有效结果，交给调用者逐组处理。
+ * 
+ * @param base64 待解码的base64字符串
+ * @param blocks 组数
+ * @param raw_data_buf 原始数据缓冲区指针，长度由调用者保证
+ * @return 已解码的组数
+ */
+static size_t base64_decode_blocks(const char *base64, size_t blocks, uint8_t *raw_data_buf)
+{
+    const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                         0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                         0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m128i nibble_mask = _mm_set1_epi8(0x0f);
+    __m128i in, hi_nibbles, lo_nibbles, roll;
+    size_t i;
+
+    for (i = 0; i < blocks; i++, base64 += 16, raw_data_buf += 12)
+    {
+        in = _mm_loadu_si128((const __m128i *)base64);
+        hi_nibbles = _mm_and_si128(_mm_srli_epi32(in, 4), nibble_mask);
+        lo_nibbles = _mm_and_si128(in, nibble_mask);
+
+        /* 按高低4位分别查表，两者相与不为0的字符不是base64字符 */
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(_mm_shuffle_epi8(lut_lo, lo_nibbles),
+                                                           _mm_shuffle_epi8(lut_hi, hi_nibbles)),
+                                             _mm_setzero_si128())) != 0)
+            break;
+
+        /* 按高4位（'/'单独处理）查出偏移量，与字符相加得到6位值，再合并为每通道3个字节 */
+        roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(in, _mm_set1_epi8('/')), hi_nibbles));
+        in = _mm_maddubs_epi16(_mm_add_epi8(in, roll), _mm_set1_epi32(0x01400140));
+        in = _mm_madd_epi16(in, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128((__m128i *)raw_data_buf, _mm_shuffle_epi8(in, pack));
+    }
+
+    return i;
+}
 
+/**
+ * @brief 编码暂存区中的数据并分发到各条的位置
+ * 
+ * @param stage 暂存区，处理后清空
+ * @param base64_buf base64缓冲区指针
+ * @param j 第一条的写入位置
+ * @param offsets 第一条的偏移
+ * @return 最后一条之后的写入位置
+ */
+static size_t base64_encode_stage_flush(base64_batch_stage_t *stage, char *base64_buf, size_t j, size_t *offsets)
+{
+    const char *encoded = (const char *)stage->out;
+    size_t blocks = stage->in_len / 12;
+    size_t full;
+    size_t k;
+
+    /* 拼接后的数据长度为3的倍数，最后不足一个向量的分组统一处理一次 */
+    base64_encode_blocks(stage->in, blocks, (char *)stage->out);
+    base64_encode_data(stage->in + blocks * 12, stage->in_len - blocks * 12, (char *)stage->out + blocks * 16);
+
+    for (k = 0; k < stage->count; k++)
+    {
+        full = stage->lens[k] / 3 * 4;
+        offsets[k] = j;
+        base64_copy(base64_buf + j, encoded, full);
+        encoded += full;
+        j += full;
+        j += base64_encode_data((const uint8_t *)stage->records[k] + stage->lens[k] / 3 * 3, stage->lens[k] % 3,
+                                base64_buf + j);
+        base64_buf[j++] = '\0';
+    }
+
+    stage->in_len = 0;
+    stage->count = 0;
+    return j;
+}
+
+/**
+ * @brief 解码暂存区中的数据并分发到各条的位置
+ * 
+ * 暂存区中含有非base64字符时放弃向量处理结果，改为逐条解码，结果与base64_decode()相同。
+ * 
+ * @param stage 暂存区，处理后清空
+ * @param raw_data_buf 原始数据缓冲区指针
+ * @param j 第一条的写入位置
+ * @param offsets 第一条的偏移
+ * @return 最后一条之后的写入位置
+ */
+static size_t base64_decode_stage_flush(base64_batch_stage_t *stage, uint8_t *raw_data_buf, size_t j, size_t *offsets)
+{
+    const uint8_t *decoded = stage->out;
+    const char *base64;
+    size_t blocks = stage->in_len / 16;
+    size_t rest = stage->in_len - blocks * 16;
+    size_t body;
+    size_t k;
+    int valid;
+
+    valid = base64_decode_blocks((const char *)stage->in, blocks, stage->out) == blocks
+         && base64_decode_data((const char *)stage->in + blocks * 16, rest, stage->out + blocks * 12) == (int)(rest / 4 * 3);
+
+    for (k = 0; k < stage->count; k++)
+    {
+        base64 = stage->records[k];
+        offsets[k] = j;
+        if (stage->lens[k] == 0)
+            continue;
+        if (!valid)
+        {
+            j += base64_decode_data(base64, stage->lens[k], raw_data_buf + j);
+            continue;
+        }
+
+        body = (stage->lens[k] - 4) / 4 * 3;
+        base64_copy(raw_data_buf + j, decoded, body);
+        decoded += body;
+        j += body;
+        j += base64_decode_data(base64 + stage->lens[k] - 4, 4, raw_data_buf + j);
+    }
+
+    stage->in_len = 0;
+    stage->count = 0;
+    return j;
+}
+#endif
@@ -56,6 +56,65 @@ char *base64_encode(const void *_raw_data, size_t raw_data_len, char *base64_buf
  */
 int base64_decode(const char *base64, void *_raw_data_buf, size_t raw_data_buf_len);
 
+/**
+ * @brief base64原地解码
+ * 
+ * 解码结果从缓冲区起始位置开始覆盖原base64字符串，无需额外的原始数据缓冲区，
+ * 适用于已持有可写缓冲区的大块数据（如接收到的HTTP body）。
+ * 遇到'\0'或到达缓冲区长度时结束，因此缓冲区无需以'\0'结尾。
+ * 
+ * @param base64 待解码的base64字符串，同时作为原始数据缓冲区
+ * @param base64_buf_len base64缓冲区长度
+ * @return 成功返回解码后的原始数据长度，失败返回<0
+ */
+int base64_decode_inplace(char *base64, size_t base64_buf_len);
+
+/**
+ * @brief 计算批量编码所需的base64缓冲区长度
+ * 
+ * @param raw_data_lens 各条原始数据长度
+ * @param count 条数
+ * @return base64缓冲区长度
+ */
+size_t calc_base64_batch_buf_size(const size_t *raw_data_lens, size_t count);
+
+/**
+ * @brief base64批量编码
+ * 
+ * 将多条数据编码到同一缓冲区并给出各条偏移。编译器开启SSSE3（如-march=native）时，各条的完整
+ * 分组拼接后按向量处理，一个向量可跨越多条数据，适合大量几十字节的短数据；否则逐条编码，
+ * 吞吐量与逐条调用base64_encode()相当。
+ * 第i条的编码结果为 base64_buf + offsets[i]，以'\0'结尾；offsets[count]为已使用的缓冲区总长度。
+ * 
+ * @param raw_data 各条原始数据指针
+ * @param raw_data_lens 各条原始数据长度
+ * @param count 条数
+ * @param base64_buf base64缓冲区指针
+ * @param base64_buf_len base64缓冲区长度，应不小于calc_base64_batch_buf_size()
+ * @param offsets 各条编码结果的偏移，需count + 1项
+ * @return 成功返回base64缓冲区指针，失败返回NULL
+ */
+char *base64_encode_batch(const void * const *raw_data, const size_t *raw_data_lens, size_t count,
+                          char *base64_buf, size_t base64_buf_len, size_t *offsets);
+
+/**
+ * @brief base64批量解码
+ * 
+ * 向量化条件及适用场景同base64_encode_batch()，各条的解码结果与逐条调用base64_decode()相同。
+ * 第i条的解码结果位于 [offsets[i], offsets[i + 1])，offsets[count]为解码数据总长度。
+ * 每条只求一次长度，边解码边检查缓冲区长度，失败时缓冲区中可能已写入前面各条的结果。
+ * 
+ * @param base64 各条base64字符串
+ * @param base64_lens 各条base64字符串长度，为NULL时按'\0'结尾的字符串处理
+ * @param count 条数
+ * @param _raw_data_buf 原始数据缓冲区指针
+ * @param raw_data_buf_len 原始数据缓冲区长度
+ * @param offsets 各条解码结果的偏移，需count + 1项
+ * @return 成功返回解码数据总长度，失败返回<0
+ */
+int base64_decode_batch(const char * const *base64, const size_t *base64_lens, size_t count,
+                        void *_raw_data_buf, size_t raw_data_buf_len, size_t *offsets);
+
 #ifdef __cplusplus
 }
 #endif
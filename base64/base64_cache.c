@@ -0,0 +1,742 @@
+/**
+ * Copyright (c) 2020-2026, Haier
+ *
+ * content-addressed dedup cache for base64 image decoding.
+ *
+ * 客户端会反复上传相同的头像、缩略图等base64图片，每次都完整解码并重写同样内容的文件。
+ * 本模块以base64数据的哈希值及长度为键，记录已解码的文件。再次遇到相同数据时不再解码，
+ * 直接由已有文件生成目标文件：
+ * - 目标文件与缓存文件为同一文件或内容已相同时直接跳过；
+ * - 否则优先reflink（写时复制，两个文件互相独立），文件系统不支持时由内核复制
+ *   （copy_file_range），初始化时指定BASE64_CACHE_FLAG_HARDLINK则改为hardlink。
+ * 各方式都先生成临时文件再rename，目标文件不会出现写了一半的状态。临时文件名包含进程号及序号，
+ * 多个进程同时生成同一目标文件时互不干扰。
+ *
+ * base64数据来自客户端，哈希值为128位SipHash-2-4，密钥在首次初始化时随机生成并随索引保存，
+ * 客户端无法构造碰撞使其他用户的图片被链接到自己的路径。缓存文件以绝对路径保存，
+ * 从其他工作目录重新加载索引后仍指向同一文件。
+ *
+ * 缓存文件可能在外部被删除或修改，命中时会核对设备号、inode、大小及修改时间，不一致则视为失效。
+ *
+ * 索引为固定容量的哈希表，所有条目串在一个LRU链表上，满时淘汰最久未使用的条目。
+ * 索引可持久化到文件，按从旧到新的顺序保存，重新加载后LRU顺序不变。
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#define LOG_TAG             "base64_cache"
+#define LOG_LVL             LOG_LVL_INFO
+
+/* copy_file_range() */
+#define _GNU_SOURCE
+
+#include "base64_cache.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/random.h>
+#include <linux/fs.h>
+#include "log.h"
+
+/*--- Defines/Macros/Types -------------------------------------------------------------------------*/
+
+/* 缓存文件路径最大长度 */
+#define BASE64_CACHE_PATH_MAX           256
+
+/* 索引文件标识及版本 */
+#define BASE64_CACHE_MAGIC              0x43343642u     /* "B64C" */
+#define BASE64_CACHE_VERSION            2
+
+/* 空索引 */
+#define BASE64_CACHE_NIL                UINT32_MAX
+
+/* 缓存记录（持久化到索引文件） */
+typedef struct
+{
+    base64_cache_key_t key;
+    uint64_t dev;                       /* 缓存文件设备号 */
+    uint64_t ino;                       /* 缓存文件inode */
+    uint64_t size;                      /* 缓存文件大小 */
+    int64_t mtime_sec;                  /* 缓存文件修改时间 */
+    int64_t mtime_nsec;
+    char path[BASE64_CACHE_PATH_MAX];   /* 缓存文件路径 */
+} base64_cache_record_t;
+
+/* 索引文件头 */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t count;
+    uint64_t hash_key[2];               /* 哈希密钥 */
+} base64_cache_file_header_t;
+
+/* 缓存条目 */
+typedef struct
+{
+    base64_cache_record_t rec;
+    uint32_t hash_next;                 /* 哈希链表下一项，空闲时为空闲链表下一项 */
+    uint32_t lru_prev;                  /* LRU链表上一项（更新） */
+    uint32_t lru_next;                  /* LRU链表下一项（更旧） */
+} base64_cache_entry_t;
+
+/* 缓存 */
+typedef struct
+{
+    base64_cache_entry_t *entries;
+    uint32_t *buckets;
+    size_t bucket_mask;
+    uint32_t free_head;
+    uint32_t lru_head;                  /* 最近使用 */
+    uint32_t lru_tail;                  /* 最久未使用 */
+    base64_cache_stats_t stats;
+    uint64_t hash_key[2];               /* 哈希密钥 */
+    char index_path[BASE64_CACHE_PATH_MAX];
+    int flags;
+    int enabled;
+} base64_cache_t;
+
+
+/*--- Prototypes -----------------------------------------------------------------------------------*/
+
+static void base64_cache_hash(const char *data, size_t len, uint64_t hash[2]);
+static uint32_t base64_cache_find(const base64_cache_key_t *key);
+static void base64_cache_lru_remove(uint32_t idx);
+static void base64_cache_lru_push_front(uint32_t idx);
+static void base64_cache_remove(uint32_t idx);
+static uint32_t base64_cache_alloc(void);
+static int base64_cache_put(const base64_cache_record_t *rec);
+static int base64_cache_valid(const base64_cache_record_t *rec);
+static int base64_cache_reflink(const char *src_path, const char *dst_path);
+static int base64_cache_copy(const char *src_path, const char *dst_path);
+static int base64_cache_same_content(const char *path1, const char *path2);
+static int base64_cache_materialize(const base64_cache_record_t *rec, const char *path);
+static int base64_cache_load(void);
+
+
+/*--- Variables ------------------------------------------------------------------------------------*/
+
+static base64_cache_t base64_cache;
+
+
+/*--- Constants ------------------------------------------------------------------------------------*/
+
+
+/*--- Global Function Implementation ---------------------------------------------------------------*/
+
+int base64_cache_init(size_t capacity, const char *index_path, int flags)
+{
+    size_t bucket_num;
+    size_t i;
+
+    if (capacity == 0 || capacity >= BASE64_CACHE_NIL)
+    {
+        log_e("Invalid arguments.");
+        return -1;
+    }
+    if (index_path != NULL && strlen(index_path) >= sizeof(base64_cache.index_path))
+    {
+        log_e("Index path too long.");
+        return -1;
+    }
+
+    base64_cache_deinit();
+
+    /* 桶数取不小于容量的2的幂 */
+    for (bucket_num = 1; bucket_num < capacity; bucket_num <<= 1);
+
+    base64_cache.entries = malloc(capacity * sizeof(base64_cache_entry_t));
+    base64_cache.buckets = malloc(bucket_num * sizeof(uint32_t));
+    if (base64_cache.entries == NULL || base64_cache.buckets == NULL)
+    {
+        log_e("No memory.");
+        free(base64_cache.entries);
+        free(base64_cache.buckets);
+        base64_cache.entries = NULL;
+        base64_cache.buckets = NULL;
+        return -1;
+    }
+
+    for (i = 0; i < bucket_num; i++)
+        base64_cache.buckets[i] = BASE64_CACHE_NIL;
+    for (i = 0; i < capacity; i++)
+        base64_cache.entries[i].hash_next = (i + 1 < capacity) ? (uint32_t)(i + 1) : BASE64_CACHE_NIL;
+    base64_cache.bucket_mask = bucket_num - 1;
+    base64_cache.free_head = 0;
+    base64_cache.lru_head = BASE64_CACHE_NIL;
+    base64_cache.lru_tail = BASE64_CACHE_NIL;
+    memset(&base64_cache.stats, 0, sizeof(base64_cache.stats));
+    base64_cache.stats.capacity = capacity;
+    if (index_path != NULL)
+        strcpy(base64_cache.index_path, index_path);
+    else
+        base64_cache.index_path[0] = '\0';
+    base64_cache.flags = flags;
+    base64_cache.enabled = 1;
+
+    /* 随机生成哈希密钥，加载索引时替换为索引中保存的密钥 */
+    if (getrandom(base64_cache.hash_key, sizeof(base64_cache.hash_key), 0) != sizeof(base64_cache.hash_key))
+    {
+        log_e("Failed to generate hash key.");
+        base64_cache.index_path[0] = '\0';
+        base64_cache_deinit();
+        return -1;
+    }
+
+    if (base64_cache.index_path[0] != '\0')
+    {
+        base64_cache_load();
+        /* 加载过程中的淘汰不计入统计 */
+        base64_cache.stats.evictions = 0;
+    }
+
+    return 0;
+}
+
+void base64_cache_deinit(void)
+{
+    if (!base64_cache.enabled)
+        return;
+
+    base64_cache_save();
+
+    free(base64_cache.entries);
+    free(base64_cache.buckets);
+    memset(&base64_cache, 0, sizeof(base64_cache));
+}
+
+int base64_cache_save(void)
+{
+    base64_cache_file_header_t header;
+    char tmp_path[BASE64_CACHE_PATH_MAX + 8];
+    FILE *fp;
+    uint32_t idx;
+    int fd;
+
+    if (!base64_cache.enabled || base64_cache.index_path[0] == '\0')
+        return -1;
+
+    /* 索引中保存有哈希密钥，仅允许所有者读写 */
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", base64_cache.index_path);
+    fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    fp = (fd >= 0) ? fdopen(fd, "wb") : NULL;
+    if (fp == NULL)
+    {
+        log_e("Failed to create index file: %s", tmp_path);
+        if (fd >= 0)
+            close(fd);
+        return -1;
+    }
+
+    header.magic = BASE64_CACHE_MAGIC;
+    header.version = BASE64_CACHE_VERSION;
+    header.count = base64_cache.stats.entries;
+    header.hash_key[0] = base64_cache.hash_key[0];
+    header.hash_key[1] = base64_cache.hash_key[1];
+    if (fwrite(&header, sizeof(header), 1, fp) != 1)
+        goto error;
+
+    /* 从旧到新保存，加载时按顺序插入即可恢复LRU顺序 */
+    for (idx = base64_cache.lru_tail; idx != BASE64_CACHE_NIL; idx = base64_cache.entries[idx].lru_prev)
+    {
+        if (fwrite(&base64_cache.entries[idx].rec, sizeof(base64_cache_record_t), 1, fp) != 1)
+            goto error;
+    }
+
+    if (fclose(fp) != 0)
+    {
+        unlink(tmp_path);
+        return -1;
+    }
+    if (rename(tmp_path, base64_cache.index_path) != 0)
+    {
+        log_e("Failed to rename index file: %s", tmp_path);
+        unlink(tmp_path);
+        return -1;
+    }
+
+    return 0;
+
+error:
+    log_e("Failed to write index file.");
+    fclose(fp);
+    unlink(tmp_path);
+    return -1;
+}
+
+int base64_cache_enabled(void)
+{
+    return base64_cache.enabled;
+}
+
+void base64_cache_get_stats(base64_cache_stats_t *stats)
+{
+    if (stats != NULL)
+        *stats = base64_cache.stats;
+}
+
+void base64_cache_make_key(const char *base64_data, size_t base64_len, base64_cache_key_t *key)
+{
+    uint64_t hash[2];
+
+    base64_cache_hash(base64_data, base64_len, hash);
+    key->hash = hash[0];
+    key->check = hash[1];
+    key->len = base64_len;
+}
+
+int base64_cache_lookup(const base64_cache_key_t *key, const char *path)
+{
+    uint32_t idx;
+    int ret;
+
+    if (!base64_cache.enabled || key == NULL || path == NULL)
+        return -1;
+
+    idx = base64_cache_find(key);
+    if (idx == BASE64_CACHE_NIL)
+    {
+        base64_cache.stats.misses++;
+        return -1;
+    }
+
+    if (!base64_cache_valid(&base64_cache.entries[idx].rec))
+    {
+        log_d("cache file changed: %s", base64_cache.entries[idx].rec.path);
+        base64_cache_remove(idx);
+        base64_cache.stats.stale++;
+        base64_cache.stats.misses++;
+        return -1;
+    }
+
+    ret = base64_cache_materialize(&base64_cache.entries[idx].rec, path);
+    if (ret < 0)
+    {
+        base64_cache.stats.misses++;
+        return -1;
+    }
+    if (ret > 0)
+        base64_cache.stats.unchanged++;
+
+    base64_cache_lru_remove(idx);
+    base64_cache_lru_push_front(idx);
+    base64_cache.stats.hits++;
+
+    return 0;
+}
+
+int base64_cache_insert(const base64_cache_key_t *key, const char *path)
+{
+    base64_cache_record_t rec;
+    char abs_path[PATH_MAX];
+    struct stat st;
+
+    if (!base64_cache.enabled || key == NULL || path == NULL)
+        return -1;
+
+    /* 以绝对路径保存，索引在其他工作目录下加载时仍指向同一文件 */
+    if (realpath(path, abs_path) == NULL || strlen(abs_path) >= sizeof(rec.path))
+        return -1;
+    if (stat(abs_path, &st) != 0)
+        return -1;
+
+    memset(&rec, 0, sizeof(rec));
+    rec.key = *key;
+    rec.dev = st.st_dev;
+    rec.ino = st.st_ino;
+    rec.size = st.st_size;
+    rec.mtime_sec = st.st_mtim.tv_sec;
+    rec.mtime_nsec = st.st_mtim.tv_nsec;
+    strcpy(rec.path, abs_path);
+
+    return base64_cache_put(&rec);
+}
+
+
+/*--- Local Function Implementation ----------------------------------------------------------------*/
+
+static inline uint64_t base64_cache_rotl(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+#define BASE64_CACHE_SIPROUND(v0, v1, v2, v3)                               \
+    do                                                                      \
+    {                                                                       \
+        v0 += v1; v1 = base64_cache_rotl(v1, 13); v1 ^= v0; v0 = base64_cache_rotl(v0, 32); \
+        v2 += v3; v3 = base64_cache_rotl(v3, 16); v3 ^= v2;                 \
+        v0 += v3; v3 = base64_cache_rotl(v3, 21); v3 ^= v0;                 \
+        v2 += v1; v1 = base64_cache_rotl(v1, 17); v1 ^= v2; v2 = base64_cache_rotl(v2, 32); \
+    } while (0)
+
+/**
+ * @brief 以缓存密钥计算128位SipHash-2-4，每次处理8字节（按小端读取）
+ */
+static void base64_cache_hash(const char *data, size_t len, uint64_t hash[2])
+{
+    uint64_t v0 = 0x736f6d6570736575ull ^ base64_cache.hash_key[0];
+    uint64_t v1 = 0x646f72616e646f6dull ^ base64_cache.hash_key[1] ^ 0xee;
+    uint64_t v2 = 0x6c7967656e657261ull ^ base64_cache.hash_key[0];
+    uint64_t v3 = 0x7465646279746573ull ^ base64_cache.hash_key[1];
+    uint64_t m;
+    size_t i;
+    int r;
+
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        memcpy(&m, data + i, 8);
+        v3 ^= m;
+        BASE64_CACHE_SIPROUND(v0, v1, v2, v3);
+        BASE64_CACHE_SIPROUND(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    /* 剩余不足8字节，最高字节为长度 */
+    m = 0;
+    memcpy(&m, data + i, len - i);
+    m |= (uint64_t)len << 56;
+    v3 ^= m;
+    BASE64_CACHE_SIPROUND(v0, v1, v2, v3);
+    BASE64_CACHE_SIPROUND(v0, v1, v2, v3);
+    v0 ^= m;
+
+    v2 ^= 0xee;
+    for (r = 0; r < 4; r++)
+        BASE64_CACHE_SIPROUND(v0, v1, v2, v3);
+    hash[0] = v0 ^ v1 ^ v2 ^ v3;
+
+    v1 ^= 0xdd;
+    for (r = 0; r < 4; r++)
+        BASE64_CACHE_SIPROUND(v0, v1, v2, v3);
+    hash[1] = v0 ^ v1 ^ v2 ^ v3;
+}
+
+static uint32_t base64_cache_find(const base64_cache_key_t *key)
+{
+    uint32_t idx;
+
+    for (idx = base64_cache.buckets[key->hash & base64_cache.bucket_mask]; idx != BASE64_CACHE_NIL;
+         idx = base64_cache.entries[idx].hash_next)
+    {
+        if (base64_cache.entries[idx].rec.key.hash == key->hash && base64_cache.entries[idx].rec.key.check == key->check
+            && base64_cache.entries[idx].rec.key.len == key->len)
+            return idx;
+    }
+
+    return BASE64_CACHE_NIL;
+}
+
+static void base64_cache_lru_remove(uint32_t idx)
+{
+    base64_cache_entry_t *entry = &base64_cache.entries[idx];
+
+    if (entry->lru_prev != BASE64_CACHE_NIL)
+        base64_cache.entries[entry->lru_prev].lru_next = entry->lru_next;
+    else
+        base64_cache.lru_head = entry->lru_next;
+
+    if (entry->lru_next != BASE64_CACHE_NIL)
+        base64_cache.entries[entry->lru_next].lru_prev = entry->lru_prev;
+    else
+        base64_cache.lru_tail = entry->lru_prev;
+}
+
+static void base64_cache_lru_push_front(uint32_t idx)
+{
+    base64_cache_entry_t *entry = &base64_cache.entries[idx];
+
+    entry->lru_prev = BASE64_CACHE_NIL;
+    entry->lru_next = base64_cache.lru_head;
+    if (base64_cache.lru_head != BASE64_CACHE_NIL)
+        base64_cache.entries[base64_cache.lru_head].lru_prev = idx;
+    else
+        base64_cache.lru_tail = idx;
+    base64_cache.lru_head = idx;
+}
+
+/**
+ * @brief 删除条目并放回空闲链表
+ */
+static void base64_cache_remove(uint32_t idx)
+{
+    uint32_t *link = &base64_cache.buckets[base64_cache.entries[idx].rec.key.hash & base64_cache.bucket_mask];
+
+    /* 从哈希链表中摘除 */
+    while (*link != idx)
+        link = &base64_cache.entries[*link].hash_next;
+    *link = base64_cache.entries[idx].hash_next;
+
+    base64_cache_lru_remove(idx);
+
+    base64_cache.entries[idx].hash_next = base64_cache.free_head;
+    base64_cache.free_head = idx;
+    base64_cache.stats.entries--;
+}
+
+/**
+ * @brief 分配空闲条目，没有空闲条目时淘汰最久未使用的条目
+ */
+static uint32_t base64_cache_alloc(void)
+{
+    uint32_t idx;
+
+    if (base64_cache.free_head == BASE64_CACHE_NIL)
+    {
+        base64_cache_remove(base64_cache.lru_tail);
+        base64_cache.stats.evictions++;
+    }
+
+    idx = base64_cache.free_head;
+    base64_cache.free_head = base64_cache.entries[idx].hash_next;
+
+    return idx;
+}
+
+static int base64_cache_put(const base64_cache_record_t *rec)
+{
+    uint32_t idx;
+    uint32_t *bucket;
+
+    /* 已存在时更新记录 */
+    idx = base64_cache_find(&rec->key);
+    if (idx != BASE64_CACHE_NIL)
+    {
+        base64_cache.entries[idx].rec = *rec;
+        base64_cache_lru_remove(idx);
+        base64_cache_lru_push_front(idx);
+        return 0;
+    }
+
+    idx = base64_cache_alloc();
+    base64_cache.entries[idx].rec = *rec;
+
+    bucket = &base64_cache.buckets[rec->key.hash & base64_cache.bucket_mask];
+    base64_cache.entries[idx].hash_next = *bucket;
+    *bucket = idx;
+
+    base64_cache_lru_push_front(idx);
+    base64_cache.stats.entries++;
+
+    return 0;
+}
+
+/**
+ * @brief 检查缓存文件是否仍为插入时的文件
+ */
+static int base64_cache_valid(const base64_cache_record_t *rec)
+{
+    struct stat st;
+
+    if (stat(rec->path, &st) != 0)
+        return 0;
+
+    return (uint64_t)st.st_dev == rec->dev
+        && (uint64_t)st.st_ino == rec->ino
+        && (uint64_t)st.st_size == rec->size
+        && st.st_mtim.tv_sec == rec->mtime_sec
+        && st.st_mtim.tv_nsec == rec->mtime_nsec;
+}
+
+/**
+ * @brief 以reflink方式复制文件，仅btrfs、xfs等支持写时复制的文件系统可用
+ */
+static int base64_cache_reflink(const char *src_path, const char *dst_path)
+{
+#ifdef FICLONE
+    int src_fd, dst_fd;
+    int ret;
+
+    src_fd = open(src_path, O_RDONLY);
+    if (src_fd < 0)
+        return -1;
+    dst_fd = open(dst_path, O_WRONLY | O_CREAT | O_EXCL, 0644);
+    if (dst_fd < 0)
+    {
+        close(src_fd);
+        return -1;
+    }
+
+    ret = ioctl(dst_fd, FICLONE, src_fd);
+    close(dst_fd);
+    close(src_fd);
+    if (ret < 0)
+    {
+        unlink(dst_path);
+        return -1;
+    }
+
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @brief 由内核复制文件，数据不经过用户态
+ */
+static int base64_cache_copy(const char *src_path, const char *dst_path)
+{
+    struct stat st;
+    ssize_t ret = 0;
+    int src_fd, dst_fd;
+
+    src_fd = open(src_path, O_RDONLY);
+    if (src_fd < 0)
+        return -1;
+    if (fstat(src_fd, &st) != 0)
+    {
+        close(src_fd);
+        return -1;
+    }
+    dst_fd = open(dst_path, O_WRONLY | O_CREAT | O_EXCL, 0644);
+    if (dst_fd < 0)
+    {
+        close(src_fd);
+        return -1;
+    }
+
+    while (st.st_size > 0)
+    {
+        ret = copy_file_range(src_fd, NULL, dst_fd, NULL, st.st_size, 0);
+        if (ret <= 0)
+            break;
+        st.st_size -= ret;
+    }
+
+    close(dst_fd);
+    close(src_fd);
+    if (st.st_size != 0)
+    {
+        unlink(dst_path);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 比较两个文件内容是否相同
+ */
+static int base64_cache_same_content(const char *path1, const char *path2)
+{
+    char buf1[4096], buf2[4096];
+    size_t len1, len2;
+    FILE *fp1, *fp2;
+    int same;
+
+    fp1 = fopen(path1, "rb");
+    if (fp1 == NULL)
+        return 0;
+    fp2 = fopen(path2, "rb");
+    if (fp2 == NULL)
+    {
+        fclose(fp1);
+        return 0;
+    }
+
+    do
+    {
+        len1 = fread(buf1, 1, sizeof(buf1), fp1);
+        len2 = fread(buf2, 1, sizeof(buf2), fp2);
+        same = len1 == len2 && memcmp(buf1, buf2, len1) == 0;
+    } while (same && len1 == sizeof(buf1));
+
+    fclose(fp2);
+    fclose(fp1);
+    return same;
+}
+
+/**
+ * @brief 由缓存文件生成目标文件
+ *
+ * @return 成功返回0，目标文件内容已相同而未写入返回1，失败返回<0
+ */
+static int base64_cache_materialize(const base64_cache_record_t *rec, const char *path)
+{
+    static unsigned int seq;
+    char tmp_path[BASE64_CACHE_PATH_MAX + 32];
+    struct stat st;
+
+    /* 目标文件已是缓存文件或内容已相同，无需写入 @{ */
+    if (stat(path, &st) == 0)
+    {
+        if ((uint64_t)st.st_dev == rec->dev && (uint64_t)st.st_ino == rec->ino)
+            return 1;
+        if (S_ISREG(st.st_mode) && (uint64_t)st.st_size == rec->size && base64_cache_same_content(rec->path, path))
+            return 1;
+    }
+    /* 目标文件已是缓存文件或内容已相同 @} */
+
+    /* 临时文件以O_EXCL创建，名称冲突时失败而不是删除他人的临时文件 */
+    if (snprintf(tmp_path, sizeof(tmp_path), "%s.%d.%u.b64c.tmp", path, (int)getpid(),
+                 __atomic_add_fetch(&seq, 1, __ATOMIC_RELAXED)) >= (int)sizeof(tmp_path))
+        return -1;
+
+    if (base64_cache_reflink(rec->path, tmp_path) != 0)
+    {
+        /* hardlink后目标文件与缓存文件共享inode，须由调用者显式允许 */
+        if ((base64_cache.flags & BASE64_CACHE_FLAG_HARDLINK) ? link(rec->path, tmp_path) != 0
+                                                               : base64_cache_copy(rec->path, tmp_path) != 0)
+        {
+            log_d("Cannot reflink, hardlink or copy %s to %s.", rec->path, path);
+            return -1;
+        }
+    }
+    if (rename(tmp_path, path) != 0)
+    {
+        unlink(tmp_path);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 从索引文件加载缓存记录
+ */
+static int base64_cache_load(void)
+{
+    base64_cache_file_header_t header;
+    base64_cache_record_t rec;
+    FILE *fp;
+    uint64_t i;
+
+    fp = fopen(base64_cache.index_path, "rb");
+    if (fp == NULL)
+        return -1;      /* 首次运行时索引文件不存在 */
+
+    if (fread(&header, sizeof(header), 1, fp) != 1
+        || header.magic != BASE64_CACHE_MAGIC || header.version != BASE64_CACHE_VERSION)
+    {
+        log_w("Invalid index file: %s", base64_cache.index_path);
+        fclose(fp);
+        return -1;
+    }
+    base64_cache.hash_key[0] = header.hash_key[0];
+    base64_cache.hash_key[1] = header.hash_key[1];
+
+    for (i = 0; i < header.count; i++)
+    {
+        if (fread(&rec, sizeof(rec), 1, fp) != 1)
+        {
+            log_w("Index file truncated: %s", base64_cache.index_path);
+            break;
+        }
+        rec.path[sizeof(rec.path) - 1] = '\0';
+        if (rec.path[0] != '/')
+            continue;
+        base64_cache_put(&rec);
+    }
+
+    fclose(fp);
+    return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2020-2026, Haier
+ *
+ * content-addressed dedup cache for base64 image decoding.
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#ifndef BASE64_CACHE_H
+#define BASE64_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--- Defines/Macros/Types -------------------------------------------------------------------------*/
+
+/* 初始化标志 */
+#define BASE64_CACHE_FLAG_HARDLINK      0x01    /* 文件系统不支持reflink时以hardlink代替复制，见base64_cache_init() */
+
+/* 缓存键：以随机密钥计算的base64数据的128位SipHash值及长度 */
+typedef struct
+{
+    uint64_t hash;
+    uint64_t check;
+    uint64_t len;
+} base64_cache_key_t;
+
+/* 缓存统计 */
+typedef struct
+{
+    uint64_t hits;              /* 命中次数（未解码即生成目标文件） */
+    uint64_t misses;            /* 未命中次数 */
+    uint64_t evictions;         /* LRU淘汰次数 */
+    uint64_t stale;             /* 缓存文件已被删除或修改而失效的次数 */
+    uint64_t unchanged;         /* 命中且目标文件内容已相同、未写入的次数 */
+    size_t entries;             /* 当前条目数 */
+    size_t capacity;            /* 最大条目数 */
+} base64_cache_stats_t;
+
+
+/*--- Global Variables -----------------------------------------------------------------------------*/
+
+
+/*--- Global Constants -----------------------------------------------------------------------------*/
+
+
+/*--- Global Prototypes ----------------------------------------------------------------------------*/
+
+/**
+ * @brief 初始化缓存，启用后base64_decode_image()会先查询缓存
+ *
+ * 命中时优先reflink（写时复制，文件互相独立），文件系统不支持时由内核复制已解码的文件，
+ * 同样省去解码。目标文件已是同一文件，或大小及内容与缓存文件相同时不再写入。注意：非线程安全。
+ *
+ * 指定BASE64_CACHE_FLAG_HARDLINK时以hardlink代替复制，目标文件与缓存文件及其他目标文件
+ * 共享同一inode，任何一方被原地修改（如以"w"模式重新打开写入）都会同时改变其他文件，
+ * 因此这些文件只能整体替换（写临时文件后rename，base64_decode_image()在启用缓存或目标文件
+ * 有多个链接时如此），
+ * 不能原地修改。
+ *
+ * 缓存键以随机密钥计算，客户端无法构造碰撞；密钥随索引保存，索引文件权限为0600。
+ *
+ * @param capacity 最大条目数，超出时淘汰最久未使用的条目
+ * @param index_path 索引持久化文件路径，存在时加载；NULL表示不持久化
+ * @param flags BASE64_CACHE_FLAG_XXX
+ * @return 成功返回0，失败返回<0
+ */
+int base64_cache_init(size_t capacity, const char *index_path, int flags);
+
+/**
+ * @brief 保存索引并释放缓存
+ */
+void base64_cache_deinit(void);
+
+/**
+ * @brief 保存索引到初始化时指定的文件
+ *
+ * @return 成功返回0，失败返回<0
+ */
+int base64_cache_save(void);
+
+/**
+ * @brief 缓存是否已启用
+ */
+int base64_cache_enabled(void);
+
+/**
+ * @brief 获取缓存统计
+ *
+ * @param stats 统计输出
+ */
+void base64_cache_get_stats(base64_cache_stats_t *stats);
+
+/**
+ * @brief 计算base64数据的缓存键
+ *
+ * @param base64_data base64数据
+ * @param base64_len base64数据长度
+ * @param key 缓存键输出
+ */
+void base64_cache_make_key(const char *base64_data, size_t base64_len, base64_cache_key_t *key);
+
+/**
+ * @brief 查询缓存，命中时由已解码的文件生成目标文件
+ *
+ * @param key 缓存键
+ * @param path 目标文件路径
+ * @return 命中并生成目标文件返回0，否则返回<0
+ */
+int base64_cache_lookup(const base64_cache_key_t *key, const char *path);
+
+/**
+ * @brief 将已解码的文件加入缓存
+ *
+ * @param key 缓存键
+ * @param path 已解码的文件路径，以绝对路径保存
+ * @return 成功返回0，失败返回<0
+ */
+int base64_cache_insert(const base64_cache_key_t *key, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BASE64_CACHE_H */
@@ -13,11 +13,15 @@
 
 #include "base64_ex.h"
 #include "base64.h"
+#include "base64_cache.h"
 #include <stdint.h>
 #include <stddef.h>
 #include <string.h>
 #include <malloc.h>
 #include <stdio.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include "log.h"
 
 /*--- Defines/Macros/Types -------------------------------------------------------------------------*/
@@ -25,23 +29,81 @@
 
 /*--- Prototypes -----------------------------------------------------------------------------------*/
 
+static const char *base64_image_data(const char *base64_img);
+static int base64_write_file(const char *path, const void *raw_data, size_t raw_data_size);
+
 
 /*--- Variables ------------------------------------------------------------------------------------*/
 
 
 /*--- Constants ------------------------------------------------------------------------------------*/
 
+
+/*--- Global Function Implementation ---------------------------------------------------------------*/
+
 int base64_decode_image(const char *base64_img, const char *path)
 {
-    char img_format[8];         /* 图像格式 */
-    char header[32];            /* 头部："data:image/XXXXXXX;base64," */
     const char *base64_data;    /* 实际的base64数据 */
     int raw_data_buf_size;      /* 解码数据缓冲区大小 */
     void *raw_data_buf;         /* 解码数据缓冲区指针 */
     int raw_data_size;          /* 解码数据大小 */
-    FILE *fp;
-    const char *temp_str;
-    int temp_int;
+    base64_cache_key_t cache_key;
+    int ret;
+
+    if (base64_img == NULL || base64_img[0] == '\0' || path == NULL || path[0] == '\0')
+    {
+        log_e("Invalid arguments.");
+        return -1;
+    }
+
+    base64_data = base64_image_data(base64_img);
+    if (base64_data == NULL)
+        return -1;
+
+    /* 查询缓存 @{ */
+    if (base64_cache_enabled())
+    {
+        base64_cache_make_key(base64_data, strlen(base64_data), &cache_key);
+        if (base64_cache_lookup(&cache_key, path) == 0)
+            return 0;
+    }
+    /* 查询缓存 @} */
+
+    /* 分配解码缓冲区 @{ */
+    raw_data_buf_size = calc_raw_data_buf_size(strlen(base64_data));
+    raw_data_buf = malloc(raw_data_buf_size);
+    if (raw_data_buf == NULL)
+    {
+        log_e("No memory.");
+        return -1;
+    }
+    /* 分配解码缓冲区 @} */
+
+    /* base64解码 @{ */
+    raw_data_size = base64_decode(base64_data, raw_data_buf, raw_data_buf_size);
+    if (raw_data_size < 0)
+    {
+        log_e("base64 decode error.");
+        free(raw_data_buf);
+        return -1;
+    }
+    /* base64解码 @} */
+
+    ret = base64_write_file(path, raw_data_buf, raw_data_size);
+    if (ret == 0 && base64_cache_enabled())
+        base64_cache_insert(&cache_key, path);
+
+    free(raw_data_buf);
+
+    return ret;
+}
+
+int base64_decode_image_inplace(char *base64_img, const char *path)
+{
+    char *base64_data;          /* 实际的base64数据，同时作为解码缓冲区 */
+    int raw_data_size;          /* 解码数据大小 */
+    base64_cache_key_t cache_key;
+    int ret;
 
     if (base64_img == NULL || base64_img[0] == '\0' || path == NULL || path[0] == '\0')
     {
@@ -49,12 +111,58 @@ int base64_decode_image(const char *base64_img, const char *path)
         return -1;
     }
 
+    base64_data = (char *)base64_image_data(base64_img);
+    if (base64_data == NULL)
+        return -1;
+
+    /* 查询缓存，须在原地解码覆盖数据之前 @{ */
+    if (base64_cache_enabled())
+    {
+        base64_cache_make_key(base64_data, strlen(base64_data), &cache_key);
+        if (base64_cache_lookup(&cache_key, path) == 0)
+            return 0;
+    }
+    /* 查询缓存 @} */
+
+    /* base64原地解码 @{ */
+    raw_data_size = base64_decode_inplace(base64_data, strlen(base64_data));
+    if (raw_data_size < 0)
+    {
+        log_e("base64 decode error.");
+        return -1;
+    }
+    /* base64原地解码 @} */
+
+    ret = base64_write_file(path, base64_data, raw_data_size);
+    if (ret == 0 && base64_cache_enabled())
+        base64_cache_insert(&cache_key, path);
+
+    return ret;
+}
+
+
+
+/*--- Local Function Implementation ----------------------------------------------------------------*/
+
+/**
+ * @brief 解析base64图片头部，定位实际的base64数据
+ * 
+ * @param base64_img base64图片字符串
+ * @return 成功返回base64数据起始位置，失败返回NULL
+ */
+static const char *base64_image_data(const char *base64_img)
+{
+    char img_format[8];         /* 图像格式 */
+    char header[32];            /* 头部："data:image/XXXXXXX;base64," */
+    const char *temp_str;
+    int temp_int;
+
     /* 定位起始位置 @{ */
     base64_img = strstr(base64_img, "data:image/");
     if (base64_img == NULL)
     {
         log_e("Invalid format. Cannot find header \"data:image/\".");
-        return -1;
+        return NULL;
     }
     /* 定位起始位置 @} */
 
@@ -63,13 +171,13 @@ int base64_decode_image(const char *base64_img, const char *path)
     if (temp_str == NULL)
     {
         log_e("Invalid format. Cannot find image format name.");
-        return -1;
+        return NULL;
     }
     temp_int = temp_str - base64_img - strlen("data:image/");   /* 计算图片扩展名长度 */
     if (temp_int > sizeof(img_format) - 1)
     {
         log_e("Invalid image format name.");
-        return -1;
+        return NULL;
     }
     strncpy(img_format, base64_img + strlen("data:image/"), temp_int);
     img_format[temp_int] = '\0';
@@ -83,58 +191,71 @@ int base64_decode_image(const char *base64_img, const char *path)
     if (strncmp(base64_img, header, strlen(header)) != 0)
     {
         log_e("Invalid format. Cannot find image header \"%s\".", header);
-        return -1;
+        return NULL;
     }
     /* 验证头部是否正确 @} */
 
-    base64_data = base64_img + strlen(header);
+    return base64_img + strlen(header);
+}
 
-    /* 分配解码缓冲区 @{ */
-    raw_data_buf_size = calc_raw_data_buf_size(strlen(base64_data));
-    raw_data_buf = malloc(raw_data_buf_size);
-    if (raw_data_buf == NULL)
-    {
-        log_e("No memory.");
-        return -1;
-    }
-    /* 分配解码缓冲区 @} */
+/**
+ * @brief 将解码数据写入文件
+ * 
+ * @param path 文件路径
+ * @param raw_data 解码数据
+ * @param raw_data_size 解码数据大小
+ * @return 成功返回0，失败返回<0
+ */
+static int base64_write_file(const char *path, const void *raw_data, size_t raw_data_size)
+{
+    static unsigned int seq;
+    char tmp_path[PATH_MAX];
+    const char *write_path = path;
+    struct stat st;
+    FILE *fp;
 
-    /* base64解码 @{ */
-    raw_data_size = base64_decode(base64_data, raw_data_buf, raw_data_buf_size);
-    if (raw_data_size < 0)
+    /*
+     * 目标文件可能与其他文件共享inode（解码缓存生成的hardlink），原地改写会同时改变其他文件，
+     * 此时先写临时文件再rename；否则直接写入，保留符号链接及文件权限、属主。
+     */
+    if (base64_cache_enabled() || (stat(path, &st) == 0 && st.st_nlink > 1))
     {
-        log_e("base64 decode error.");
-        free(raw_data_buf);
-        return -1;
+        if (snprintf(tmp_path, sizeof(tmp_path), "%s.%d.%u.tmp", path, (int)getpid(),
+                     __atomic_add_fetch(&seq, 1, __ATOMIC_RELAXED)) >= (int)sizeof(tmp_path))
+        {
+            log_e("Path too long: %s", path);
+            return -1;
+        }
+        write_path = tmp_path;
     }
-    /* base64解码 @} */
 
-    /* 存文件 @{ */
-    fp = fopen(path, "wb");
+    fp = fopen(write_path, "wb");
     if (fp == NULL)
     {
-        log_e("Failed to create image file: %s", path);
-        free(raw_data_buf);
+        log_e("Failed to create image file: %s", write_path);
         return -1;
     }
-    if (fwrite(raw_data_buf, raw_data_size, 1, fp) != 1)
+    if (fwrite(raw_data, raw_data_size, 1, fp) != 1)
     {
         log_e("Failed to write file.");
         fclose(fp);
-        free(raw_data_buf);
+        if (write_path != path)
+            unlink(tmp_path);
+        return -1;
+    }
+    if (fclose(fp) != 0)
+    {
+        log_e("Failed to write file.");
+        if (write_path != path)
+            unlink(tmp_path);
+        return -1;
+    }
+    if (write_path != path && rename(tmp_path, path) != 0)
+    {
+        log_e("Failed to replace image file: %s", path);
+        unlink(tmp_path);
         return -1;
     }
-    fclose(fp);
-    /* 存文件 @} */
-
-    free(raw_data_buf);
-
-   
 
     return 0;
 }
-
-
-
-/*--- Local Function Implementation ----------------------------------------------------------------*/
-
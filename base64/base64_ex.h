@@ -41,6 +41,18 @@ extern "C" {
  */
 int base64_decode_image(const char *base64_img, const char *path);
 
+/**
+ * @brief base64图片原地解码
+ * 
+ * 与base64_decode_image()相同，但解码结果直接覆盖base64_img中的base64数据，不再分配解码缓冲区。
+ * 调用后base64_img的内容不再可用。
+ * 
+ * @param base64_img 待解码的base64字符串，同时作为解码缓冲区
+ * @param path 待存储的图片文件路径
+ * @return 成功返回0，失败返回<0
+ */
+int base64_decode_image_inplace(char *base64_img, const char *path);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,358 @@
+/**
+ * Copyright (c) 2020-2026, Haier
+ *
+ * base85 codec (Z85 / Ascii85).
+ *
+ * base85将每4个字节视为一个32位大端整数，用5个85进制数字表示（85^5 > 2^32），编码后的数据为原来的5/4，
+ * 比base64的4/3更紧凑。两种变体只是字母表及尾部处理不同：
+ * - Z85（ZeroMQ RFC 32）：字母表避开引号和反斜杠，可直接嵌入源码及JSON字符串；要求原始数据长度为4的倍数。
+ * - Ascii85（Adobe/btoa）：字母表为 '!'~'u'，全0的4字节组缩写为"z"；尾部不足4字节时补0编码后只输出n+1个字符。
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#include "base85.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/*--- Defines/Macros/Types -------------------------------------------------------------------------*/
+
+/* Ascii85字母表起始字符 */
+#define ASCII85_FIRST_CHAR              '!'
+
+
+/*--- Prototypes -----------------------------------------------------------------------------------*/
+
+static void base85_encode_word(uint32_t value, char *out, const char *encode_lut);
+static int base85_decode_word(const char *in, uint32_t *value, const uint8_t *decode_lut);
+static int ascii85_is_space(char c);
+
+
+/*--- Variables ------------------------------------------------------------------------------------*/
+
+
+/*--- Constants ------------------------------------------------------------------------------------*/
+
+/* Z85编码查找表 */
+static const char z85_encode_lut[85] = 
+    "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.-:+=^!/*?&<>()[]{}@%$#";
+
+/* Ascii85编码查找表 */
+static const char ascii85_encode_lut[85] = 
+    "!\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstu";
+
+/* Z85解码查找表 */
+static const uint8_t z85_decode_lut[256] = 
+{
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x00 ~ 0x07 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x08 ~ 0x0f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x10 ~ 0x17 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x18 ~ 0x1f */
+    0xff, 0x44, 0xff, 0x54, 0x53, 0x52, 0x48, 0xff,     /* ASCII: 0x20 ~ 0x27 */
+    0x4b, 0x4c, 0x46, 0x41, 0xff, 0x3f, 0x3e, 0x45,     /* ASCII: 0x28 ~ 0x2f */
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,     /* ASCII: 0x30 ~ 0x37 */
+    0x08, 0x09, 0x40, 0xff, 0x49, 0x42, 0x4a, 0x47,     /* ASCII: 0x38 ~ 0x3f */
+    0x51, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a,     /* ASCII: 0x40 ~ 0x47 */
+    0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32,     /* ASCII: 0x48 ~ 0x4f */
+    0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a,     /* ASCII: 0x50 ~ 0x57 */
+    0x3b, 0x3c, 0x3d, 0x4d, 0xff, 0x4e, 0x43, 0xff,     /* ASCII: 0x58 ~ 0x5f */
+    0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,     /* ASCII: 0x60 ~ 0x67 */
+    0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,     /* ASCII: 0x68 ~ 0x6f */
+    0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20,     /* ASCII: 0x70 ~ 0x77 */
+    0x21, 0x22, 0x23, 0x4f, 0xff, 0x50, 0xff, 0xff,     /* ASCII: 0x78 ~ 0x7f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x80 ~ 0x87 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x88 ~ 0x8f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x90 ~ 0x97 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x98 ~ 0x9f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xa0 ~ 0xa7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xa8 ~ 0xaf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xb0 ~ 0xb7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xb8 ~ 0xbf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xc0 ~ 0xc7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xc8 ~ 0xcf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xd0 ~ 0xd7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xd8 ~ 0xdf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xe0 ~ 0xe7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xe8 ~ 0xef */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xf0 ~ 0xf7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xf8 ~ 0xff */
+};
+
+/* Ascii85解码查找表 */
+static const uint8_t ascii85_decode_lut[256] = 
+{
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x00 ~ 0x07 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x08 ~ 0x0f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x10 ~ 0x17 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x18 ~ 0x1f */
+    0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,     /* ASCII: 0x20 ~ 0x27 */
+    0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,     /* ASCII: 0x28 ~ 0x2f */
+    0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,     /* ASCII: 0x30 ~ 0x37 */
+    0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e,     /* ASCII: 0x38 ~ 0x3f */
+    0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26,     /* ASCII: 0x40 ~ 0x47 */
+    0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e,     /* ASCII: 0x48 ~ 0x4f */
+    0x2f, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,     /* ASCII: 0x50 ~ 0x57 */
+    0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e,     /* ASCII: 0x58 ~ 0x5f */
+    0x3f, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46,     /* ASCII: 0x60 ~ 0x67 */
+    0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e,     /* ASCII: 0x68 ~ 0x6f */
+    0x4f, 0x50, 0x51, 0x52, 0x53, 0x54, 0xff, 0xff,     /* ASCII: 0x70 ~ 0x77 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x78 ~ 0x7f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x80 ~ 0x87 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x88 ~ 0x8f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x90 ~ 0x97 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x98 ~ 0x9f */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xa0 ~ 0xa7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xa8 ~ 0xaf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xb0 ~ 0xb7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xb8 ~ 0xbf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xc0 ~ 0xc7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xc8 ~ 0xcf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xd0 ~ 0xd7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xd8 ~ 0xdf */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xe0 ~ 0xe7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xe8 ~ 0xef */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xf0 ~ 0xf7 */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0xf8 ~ 0xff */
+};
+
+
+/*--- Global Function Implementation ---------------------------------------------------------------*/
+
+char *z85_encode(const void *_raw_data, size_t raw_data_len, char *z85_buf, size_t z85_buf_len)
+{
+    const uint8_t * const raw_data = _raw_data;
+
+    size_t i, j;
+
+    /* 检查参数合法性 */
+    if (raw_data == NULL || z85_buf == NULL)
+        return NULL;
+    if (raw_data_len % 4 != 0)
+        return NULL;
+    if (z85_buf_len < calc_z85_buf_size(raw_data_len))
+        return NULL;
+
+    /* 每4个字节为一组进行处理 */
+    for (i = 0, j = 0; i < raw_data_len; i += 4, j += 5)
+    {
+        base85_encode_word(((uint32_t)raw_data[i] << 24) | ((uint32_t)raw_data[i + 1] << 16)
+                           | ((uint32_t)raw_data[i + 2] << 8) | raw_data[i + 3], z85_buf + j, z85_encode_lut);
+    }
+
+    z85_buf[j] = '\0';
+    return z85_buf;
+}
+
+int z85_decode(const char *z85, void *_raw_data_buf, size_t raw_data_buf_len)
+{
+    uint8_t * const raw_data_buf = _raw_data_buf;
+
+    size_t i, j;
+    size_t z85_len;
+    uint32_t value;
+
+    /* 检查参数合法性 */
+    if (z85 == NULL || raw_data_buf == NULL)
+        return -1;
+    if (z85[0] == '\0')
+        return 0;
+    z85_len = strlen(z85) / 5 * 5;          /* 截断到合法长度，与base64_decode()保持一致 */
+    if (z85_len == 0)
+        return -1;
+    if (raw_data_buf_len < calc_z85_raw_data_buf_size(z85_len))
+        return -1;
+
+    /* 每5个字符为一组进行处理 */
+    for (i = 0, j = 0; i < z85_len; i += 5)
+    {
+        if (base85_decode_word(z85 + i, &value, z85_decode_lut) < 0)
+            break;  /* 无效编码 */
+
+        raw_data_buf[j++] = (uint8_t)(value >> 24);
+        raw_data_buf[j++] = (uint8_t)(value >> 16);
+        raw_data_buf[j++] = (uint8_t)(value >> 8);
+        raw_data_buf[j++] = (uint8_t)value;
+    }
+
+    return j;
+}
+
+char *ascii85_encode(const void *_raw_data, size_t raw_data_len, char *ascii85_buf, size_t ascii85_buf_len)
+{
+    const uint8_t * const raw_data = _raw_data;
+
+    size_t i, j;
+    size_t remain;
+    uint32_t value;
+    char temp[5];
+    int k;
+
+    /* 检查参数合法性 */
+    if (raw_data == NULL || ascii85_buf == NULL)
+        return NULL;
+    if (ascii85_buf_len < calc_ascii85_buf_size(raw_data_len))
+        return NULL;
+
+    /* 每4个字节为一组进行处理 */
+    for (i = 0, j = 0; i + 4 <= raw_data_len; i += 4)
+    {
+        value = ((uint32_t)raw_data[i] << 24) | ((uint32_t)raw_data[i + 1] << 16)
+              | ((uint32_t)raw_data[i + 2] << 8) | raw_data[i + 3];
+        if (value == 0)
+        {
+            ascii85_buf[j++] = 'z';
+            continue;
+        }
+        base85_encode_word(value, ascii85_buf + j, ascii85_encode_lut);
+        j += 5;
+    }
+
+    /* 剩余不足4个字节时补0编码，只输出前n+1个字符 */
+    remain = raw_data_len - i;
+    if (remain > 0)
+    {
+        value = 0;
+        for (k = 0; k < (int)remain; k++)
+            value |= (uint32_t)raw_data[i + k] << (24 - k * 8);
+        base85_encode_word(value, temp, ascii85_encode_lut);
+        memcpy(ascii85_buf + j, temp, remain + 1);
+        j += remain + 1;
+    }
+
+    ascii85_buf[j] = '\0';
+    return ascii85_buf;
+}
+
+int ascii85_decode(const char *ascii85, void *_raw_data_buf, size_t raw_data_buf_len)
+{
+    uint8_t * const raw_data_buf = _raw_data_buf;
+
+    size_t i, j;
+    size_t raw_data_len;
+    size_t count;
+    uint32_t value;
+    char group[5];
+    int k;
+
+    /* 检查参数合法性 */
+    if (ascii85 == NULL || raw_data_buf == NULL)
+        return -1;
+    if (ascii85[0] == '\0')
+        return 0;
+
+    /* 计算原始数据长度 @{ */
+    for (i = 0, count = 0, raw_data_len = 0; ascii85[i] != '\0'; i++)
+    {
+        if (ascii85_is_space(ascii85[i]))
+            continue;
+        if (ascii85[i] == 'z' && count % 5 == 0)
+            raw_data_len += 4;
+        else
+            count++;
+    }
+    raw_data_len += count / 5 * 4 + (count % 5 ? count % 5 - 1 : 0);
+    if (raw_data_buf_len < raw_data_len)
+        return -1;
+    /* 计算原始数据长度 @} */
+
+    /* 每5个有效字符为一组进行处理 */
+    for (i = 0, j = 0, k = 0; ; i++)
+    {
+        if (ascii85[i] != '\0')
+        {
+            if (ascii85_is_space(ascii85[i]))
+                continue;
+            if (ascii85[i] == 'z' && k == 0)
+            {
+                memset(raw_data_buf + j, 0, 4);
+                j += 4;
+                continue;
+            }
+            group[k++] = ascii85[i];
+            if (k < 5)
+                continue;
+        }
+        else if (k == 0)
+        {
+            break;
+        }
+        else if (k == 1)
+        {
+            break;  /* 无效编码：尾部单个字符不能表示任何字节 */
+        }
+
+        /* 尾部不足5个字符时用字母表最后一个字符补足，只取前k-1个字节 */
+        count = k;
+        while (k < 5)
+            group[k++] = ascii85_encode_lut[84];
+
+        if (base85_decode_word(group, &value, ascii85_decode_lut) < 0)
+            break;  /* 无效编码 */
+
+        raw_data_buf[j++] = (uint8_t)(value >> 24);
+        if (count > 2)
+            raw_data_buf[j++] = (uint8_t)(value >> 16);
+        if (count > 3)
+            raw_data_buf[j++] = (uint8_t)(value >> 8);
+        if (count > 4)
+            raw_data_buf[j++] = (uint8_t)value;
+        k = 0;
+
+        if (ascii85[i] == '\0')
+            break;
+    }
+
+    return j;
+}
+
+
+/*--- Local Function Implementation ----------------------------------------------------------------*/
+
+/**
+ * @brief 将32位整数编码为5个base85字符（高位在前）
+ */
+static void base85_encode_word(uint32_t value, char *out, const char *encode_lut)
+{
+    out[4] = encode_lut[value % 85];
+    value /= 85;
+    out[3] = encode_lut[value % 85];
+    value /= 85;
+    out[2] = encode_lut[value % 85];
+    value /= 85;
+    out[1] = encode_lut[value % 85];
+    value /= 85;
+    out[0] = encode_lut[value];
+}
+
+/**
+ * @brief 将5个base85字符解码为32位整数
+ * 
+ * @return 成功返回0，含无效字符或数值溢出返回<0
+ */
+static int base85_decode_word(const char *in, uint32_t *value, const uint8_t *decode_lut)
+{
+    uint64_t sum = 0;
+    uint8_t temp;
+    int k;
+
+    for (k = 0; k < 5; k++)
+    {
+        temp = decode_lut[(uint8_t)in[k]];
+        if (temp == 0xff)
+            return -1;
+        sum = sum * 85 + temp;
+    }
+    if (sum > 0xffffffffu)
+        return -1;
+
+    *value = (uint32_t)sum;
+    return 0;
+}
+
+static int ascii85_is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
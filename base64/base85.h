@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2020-2026, Haier
+ *
+ * base85 codec (Z85 / Ascii85).
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#ifndef BASE85_H
+#define BASE85_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--- Defines/Macros/Types -------------------------------------------------------------------------*/
+
+/* 由Z85字符串长度计算原始数据缓冲区长度 */
+#define calc_z85_raw_data_buf_size(z85_size)            ((z85_size) / 5 * 4)
+
+/* 由原始数据长度计算Z85缓冲区长度（原始数据长度须为4的倍数） */
+#define calc_z85_buf_size(raw_data_size)                ((raw_data_size) / 4 * 5 + 1)
+
+/**
+ * 由Ascii85字符串长度计算原始数据缓冲区长度
+ * NOTE: 不含"z"缩写时准确；每个"z"额外对应3字节，可用ascii85_decode()的返回值确认所需长度
+ */
+#define calc_ascii85_raw_data_buf_size(ascii85_size)    ((ascii85_size) / 5 * 4 + ((ascii85_size) % 5 ? (ascii85_size) % 5 - 1 : 0))
+
+/* 由原始数据长度计算Ascii85缓冲区长度（不含"z"缩写时的最大长度） */
+#define calc_ascii85_buf_size(raw_data_size)            ((raw_data_size) / 4 * 5 + ((raw_data_size) % 4 ? (raw_data_size) % 4 + 1 : 0) + 1)
+
+
+/*--- Global Variables -----------------------------------------------------------------------------*/
+
+
+/*--- Global Constants -----------------------------------------------------------------------------*/
+
+
+/*--- Global Prototypes ----------------------------------------------------------------------------*/
+
+/**
+ * @brief Z85编码（ZeroMQ RFC 32）
+ *
+ * @param _raw_data 待编码的原始数据，长度须为4的倍数
+ * @param raw_data_len 原始数据长度
+ * @param z85_buf Z85缓冲区指针
+ * @param z85_buf_len Z85缓冲区长度
+ * @return 成功返回编码后的字符串指针，失败返回NULL
+ */
+char *z85_encode(const void *_raw_data, size_t raw_data_len, char *z85_buf, size_t z85_buf_len);
+
+/**
+ * @brief Z85解码
+ *
+ * @param z85 待解码的Z85字符串
+ * @param _raw_data_buf 原始数据缓冲区指针
+ * @param raw_data_buf_len 原始数据缓冲区长度
+ * @return 成功返回解码后的原始数据长度，失败返回<0
+ */
+int z85_decode(const char *z85, void *_raw_data_buf, size_t raw_data_buf_len);
+
+/**
+ * @brief Ascii85编码（Adobe/btoa字母表 '!'~'u'，全0组缩写为"z"，不含"<~ ~>"定界符）
+ *
+ * @param _raw_data 待编码的原始数据
+ * @param raw_data_len 原始数据长度
+ * @param ascii85_buf Ascii85缓冲区指针
+ * @param ascii85_buf_len Ascii85缓冲区长度
+ * @return 成功返回编码后的字符串指针，失败返回NULL
+ */
+char *ascii85_encode(const void *_raw_data, size_t raw_data_len, char *ascii85_buf, size_t ascii85_buf_len);
+
+/**
+ * @brief Ascii85解码，忽略空白字符
+ *
+ * @param ascii85 待解码的Ascii85字符串
+ * @param _raw_data_buf 原始数据缓冲区指针
+ * @param raw_data_buf_len 原始数据缓冲区长度
+ * @return 成功返回解码后的原始数据长度，失败返回<0
+ */
+int ascii85_decode(const char *ascii85, void *_raw_data_buf, size_t raw_data_buf_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BASE85_H */
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2021-2026, Haier
+ *
+ * benchmark for base64 and the other binary-to-text codecs.
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#define LOG_TAG             "Bench"
+#define LOG_LVL             LOG_LVL_INFO
+
+#include "base64.h"
+#include "base32.h"
+#include "base16.h"
+#include "base85.h"
+#include "perf_counter.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "log.h"
+
+/* 测试数据长度 */
+#define BENCH_DATA_SIZE                 (16 * 1024 * 1024)
+
+/* 短数据编解码测试：每条长度及条数（逐条调用与批量接口对比） */
+#define BENCH_RECORD_SIZE               32
+#define BENCH_RECORD_NUM                (BENCH_DATA_SIZE / BENCH_RECORD_SIZE)
+
+int main(int argc, char *argv[])
+{
+    perf_counter_t pc;
+    uint8_t *raw_data;
+    uint8_t *raw_data_buf;
+    char *base64_buf;
+    size_t base64_buf_size = calc_base16_buf_size(BENCH_DATA_SIZE);   /* 按最长的base16分配，各编码共用 */
+    size_t i;
+    const void **records;
+    const char **base64_records;
+    size_t *record_lens;
+    size_t *offsets;
+
+    raw_data = malloc(BENCH_DATA_SIZE);
+    raw_data_buf = malloc(BENCH_DATA_SIZE);
+    base64_buf = malloc(base64_buf_size);
+    if (raw_data == NULL || raw_data_buf == NULL || base64_buf == NULL)
+    {
+        log_e("No memory.");
+        return -1;
+    }
+
+    srand(0);
+    for (i = 0; i < BENCH_DATA_SIZE; i++)
+        raw_data[i] = (uint8_t)rand();
+    /* 预先访问输出缓冲区，避免首次缺页计入第一项测试 */
+    memset(raw_data_buf, 0, BENCH_DATA_SIZE);
+    memset(base64_buf, 0, base64_buf_size);
+
+    perf_counter_open(&pc);
+
+    perf_counter_region(&pc, "base64_encode", BENCH_DATA_SIZE)
+    {
+        base64_encode(raw_data, BENCH_DATA_SIZE, base64_buf, base64_buf_size);
+    }
+    perf_counter_region(&pc, "base64_decode", BENCH_DATA_SIZE)
+    {
+        base64_decode(base64_buf, raw_data_buf, BENCH_DATA_SIZE);
+    }
+    test_assert(memcmp(raw_data, raw_data_buf, BENCH_DATA_SIZE) == 0);
+
+    perf_counter_region(&pc, "base32_encode", BENCH_DATA_SIZE)
+    {
+        base32_encode(raw_data, BENCH_DATA_SIZE, base64_buf, base64_buf_size);
+    }
+    perf_counter_region(&pc, "base32_decode", BENCH_DATA_SIZE)
+    {
+        base32_decode(base64_buf, raw_data_buf, BENCH_DATA_SIZE);
+    }
+    test_assert(memcmp(raw_data, raw_data_buf, BENCH_DATA_SIZE) == 0);
+
+    perf_counter_region(&pc, "base16_encode", BENCH_DATA_SIZE)
+    {
+        base16_encode(raw_data, BENCH_DATA_SIZE, base64_buf, base64_buf_size);
+    }
+    perf_counter_region(&pc, "base16_decode", BENCH_DATA_SIZE)
+    {
+        base16_decode(base64_buf, raw_data_buf, BENCH_DATA_SIZE);
+    }
+    test_assert(memcmp(raw_data, raw_data_buf, BENCH_DATA_SIZE) == 0);
+
+    perf_counter_region(&pc, "z85_encode", BENCH_DATA_SIZE)
+    {
+        z85_encode(raw_data, BENCH_DATA_SIZE, base64_buf, base64_buf_size);
+    }
+    perf_counter_region(&pc, "z85_decode", BENCH_DATA_SIZE)
+    {
+        z85_decode(base64_buf, raw_data_buf, BENCH_DATA_SIZE);
+    }
+    test_assert(memcmp(raw_data, raw_data_buf, BENCH_DATA_SIZE) == 0);
+
+    perf_counter_region(&pc, "ascii85_encode", BENCH_DATA_SIZE)
+    {
+        ascii85_encode(raw_data, BENCH_DATA_SIZE, base64_buf, base64_buf_size);
+    }
+    perf_counter_region(&pc, "ascii85_decode", BENCH_DATA_SIZE)
+    {
+        ascii85_decode(base64_buf, raw_data_buf, BENCH_DATA_SIZE);
+    }
+    test_assert(memcmp(raw_data, raw_data_buf, BENCH_DATA_SIZE) == 0);
+
+    /* 短数据：逐条调用与批量接口对比 @{ */
+    records = malloc(BENCH_RECORD_NUM * sizeof(*records));
+    base64_records = malloc(BENCH_RECORD_NUM * sizeof(*base64_records));
+    record_lens = malloc(BENCH_RECORD_NUM * sizeof(*record_lens));
+    offsets = malloc((BENCH_RECORD_NUM + 1) * sizeof(*offsets));
+    if (records == NULL || base64_records == NULL || record_lens == NULL || offsets == NULL)
+    {
+        log_e("No memory.");
+        return -1;
+    }
+    for (i = 0; i < BENCH_RECORD_NUM; i++)
+    {
+        records[i] = raw_data + i * BENCH_RECORD_SIZE;
+        record_lens[i] = BENCH_RECORD_SIZE;
+    }
+
+    perf_counter_region(&pc, "base64_encode x32B", BENCH_DATA_SIZE)
+    {
+        for (i = 0; i < BENCH_RECORD_NUM; i++)
+            base64_encode(records[i], BENCH_RECORD_SIZE, base64_buf + i * calc_base64_buf_size(BENCH_RECORD_SIZE),
+                          calc_base64_buf_size(BENCH_RECORD_SIZE));
+    }
+    perf_counter_region(&pc, "base64_decode x32B", BENCH_DATA_SIZE)
+    {
+        for (i = 0; i < BENCH_RECORD_NUM; i++)
+            base64_decode(base64_buf + i * calc_base64_buf_size(BENCH_RECORD_SIZE), raw_data_buf + i * BENCH_RECORD_SIZE,
+                          BENCH_RECORD_SIZE);
+    }
+    test_assert(memcmp(raw_data, raw_data_buf, BENCH_DATA_SIZE) == 0);
+
+    perf_counter_region(&pc, "base64_encode_batch x32B", BENCH_DATA_SIZE)
+    {
+        base64_encode_batch(records, record_lens, BENCH_RECORD_NUM, base64_buf, base64_buf_size, offsets);
+    }
+    for (i = 0; i < BENCH_RECORD_NUM; i++)
+    {
+        base64_records[i] = base64_buf + offsets[i];
+        record_lens[i] = offsets[i + 1] - offsets[i] - 1;
+    }
+    perf_counter_region(&pc, "base64_decode_batch x32B", BENCH_DATA_SIZE)
+    {
+        base64_decode_batch(base64_records, record_lens, BENCH_RECORD_NUM, raw_data_buf, BENCH_DATA_SIZE, offsets);
+    }
+    test_assert(memcmp(raw_data, raw_data_buf, BENCH_DATA_SIZE) == 0);
+
+    free(offsets);
+    free(record_lens);
+    free(base64_records);
+    free(records);
+    /* 短数据：逐条调用与批量接口对比 @} */
+
+    perf_counter_close(&pc);
+    free(base64_buf);
+    free(raw_data_buf);
+    free(raw_data);
+
+    return 0;
+}
@@ -3,14 +3,16 @@
 
 #include <string>
 #include <cstring>
+#include "ByteType.hpp"
+#include "ByteArrayOps.hpp"
 
-#if 1
-using byte_t = unsigned char;
-#else
-using byte_t = char;
-#endif
-
-class ByteArray : public std::basic_string<byte_t>
+/**
+ * 基于std::basic_string的字节数组，位运算及base64原地解码见ByteArrayOps。
+ *
+ * 适用于一般大小的数据。需要不断追加到数百MB的数据改用HugeByteArray（HugeByteArray.hpp）：
+ * 超过阈值后改用匿名mmap，扩容由mremap移动页表而不拷贝数据，两者的成员函数相同。
+ */
+class ByteArray : public std::basic_string<byte_t>, public ByteArrayOps<ByteArray>
 {
 public:
     ByteArray() = default;
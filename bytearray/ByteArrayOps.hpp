@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) 2021-2026, Haier
+ *
+ * member functions shared by ByteArray and HugeByteArray.
+ *
+ * 以CRTP方式实现，Derived需提供data()、size()、resize()及Derived(size)构造函数。
+ * 运算本身由ByteOps完成，两种容器的性能相同。
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#ifndef BYTE_ARRAY_OPS_HPP
+#define BYTE_ARRAY_OPS_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include "base64.h"
+#include "ByteType.hpp"
+#include "ByteOps.hpp"
+
+template <typename Derived>
+class ByteArrayOps
+{
+public:
+    /**
+     * @brief 将内容作为base64字符串原地解码，成功后内容替换为解码数据
+     *
+     * @return 成功返回解码后的数据长度，失败返回<0且内容不确定
+     */
+    int decodeBase64InPlace()
+    {
+        int len = base64_decode_inplace(reinterpret_cast<char *>(self().data()), self().size());
+        if (len >= 0)
+            self().resize(len);
+        return len;
+    }
+
+    /* 原地位运算，与另一缓冲区运算时只处理两者长度较小的部分 @{ */
+    Derived &xorMask(const byte_t *key, size_t keyLen, size_t keyOffset = 0)
+    {
+        ByteOps::xorRepeat(self().data(), self().data(), self().size(), key, keyLen, keyOffset);
+        return self();
+    }
+
+    Derived &xorWith(const byte_t *other, size_t len)
+    {
+        ByteOps::xorBytes(self().data(), self().data(), other, std::min<size_t>(self().size(), len));
+        return self();
+    }
+
+    Derived &xorWith(const Derived &other)
+    {
+        return xorWith(other.data(), other.size());
+    }
+
+    Derived &andWith(const byte_t *other, size_t len)
+    {
+        ByteOps::andBytes(self().data(), self().data(), other, std::min<size_t>(self().size(), len));
+        return self();
+    }
+
+    Derived &andWith(const Derived &other)
+    {
+        return andWith(other.data(), other.size());
+    }
+
+    Derived &orWith(const byte_t *other, size_t len)
+    {
+        ByteOps::orBytes(self().data(), self().data(), other, std::min<size_t>(self().size(), len));
+        return self();
+    }
+
+    Derived &orWith(const Derived &other)
+    {
+        return orWith(other.data(), other.size());
+    }
+
+    Derived &invert()
+    {
+        ByteOps::notBytes(self().data(), self().data(), self().size());
+        return self();
+    }
+
+    Derived &byteSwap16()
+    {
+        ByteOps::byteSwap16(self().data(), self().data(), self().size());
+        return self();
+    }
+
+    Derived &byteSwap32()
+    {
+        ByteOps::byteSwap32(self().data(), self().data(), self().size());
+        return self();
+    }
+
+    Derived &byteSwap64()
+    {
+        ByteOps::byteSwap64(self().data(), self().data(), self().size());
+        return self();
+    }
+
+    Derived &translate(const byte_t table[256])
+    {
+        ByteOps::translate(self().data(), self().data(), self().size(), table);
+        return self();
+    }
+    /* 原地位运算 @} */
+
+    /* 非原地位运算，返回新的对象，与另一缓冲区运算时结果长度为两者长度较小者 @{ */
+    Derived xorMasked(const byte_t *key, size_t keyLen, size_t keyOffset = 0) const
+    {
+        Derived result(self().size());
+        ByteOps::xorRepeat(result.data(), self().data(), self().size(), key, keyLen, keyOffset);
+        return result;
+    }
+
+    Derived xored(const Derived &other) const
+    {
+        Derived result(std::min<size_t>(self().size(), other.size()));
+        ByteOps::xorBytes(result.data(), self().data(), other.data(), result.size());
+        return result;
+    }
+
+    Derived anded(const Derived &other) const
+    {
+        Derived result(std::min<size_t>(self().size(), other.size()));
+        ByteOps::andBytes(result.data(), self().data(), other.data(), result.size());
+        return result;
+    }
+
+    Derived ored(const Derived &other) const
+    {
+        Derived result(std::min<size_t>(self().size(), other.size()));
+        ByteOps::orBytes(result.data(), self().data(), other.data(), result.size());
+        return result;
+    }
+
+    Derived inverted() const
+    {
+        Derived result(self().size());
+        ByteOps::notBytes(result.data(), self().data(), self().size());
+        return result;
+    }
+
+    Derived byteSwapped16() const
+    {
+        Derived result(self().size());
+        ByteOps::byteSwap16(result.data(), self().data(), self().size());
+        return result;
+    }
+
+    Derived byteSwapped32() const
+    {
+        Derived result(self().size());
+        ByteOps::byteSwap32(result.data(), self().data(), self().size());
+        return result;
+    }
+
+    Derived byteSwapped64() const
+    {
+        Derived result(self().size());
+        ByteOps::byteSwap64(result.data(), self().data(), self().size());
+        return result;
+    }
+
+    Derived translated(const byte_t table[256]) const
+    {
+        Derived result(self().size());
+        ByteOps::translate(result.data(), self().data(), self().size(), table);
+        return result;
+    }
+    /* 非原地位运算 @} */
+
+private:
+    Derived &self() noexcept
+    {
+        return static_cast<Derived &>(*this);
+    }
+
+    const Derived &self() const noexcept
+    {
+        return static_cast<const Derived &>(*this);
+    }
+};
+
+
+#endif  /* BYTE_ARRAY_OPS_HPP */
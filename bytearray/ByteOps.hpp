@@ -0,0 +1,337 @@
+/**
+ * Copyright (c) 2021-2026, Haier
+ *
+ * vectorized bulk bitwise transforms on byte buffers.
+ *
+ * 所有函数的dst可以与src相同（原地处理），但不能部分重叠。
+ * 编译器开启AVX2（-mavx2）时每次处理32字节，否则在支持SSE2的平台上每次处理16字节，
+ * 其余平台退化为逐字节处理。主循环前逐元素处理到dst对齐，主循环后逐元素处理剩余数据，
+ * 因此缓冲区地址和长度均无对齐要求。
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#ifndef BYTE_OPS_HPP
+#define BYTE_OPS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "ByteType.hpp"
+
+namespace ByteOps
+{
+
+namespace detail
+{
+
+#if defined(__AVX2__)
+
+using vec_t = __m256i;
+constexpr size_t VEC_SIZE = 32;
+
+inline vec_t load(const byte_t *p) { return _mm256_loadu_si256(reinterpret_cast<const vec_t *>(p)); }
+inline void store(byte_t *p, vec_t v) { _mm256_storeu_si256(reinterpret_cast<vec_t *>(p), v); }
+inline vec_t vxor(vec_t a, vec_t b) { return _mm256_xor_si256(a, b); }
+inline vec_t vand(vec_t a, vec_t b) { return _mm256_and_si256(a, b); }
+inline vec_t vor(vec_t a, vec_t b) { return _mm256_or_si256(a, b); }
+inline vec_t vnot(vec_t a) { return _mm256_xor_si256(a, _mm256_set1_epi8(-1)); }
+
+inline vec_t vbswap16(vec_t a)
+{
+    const vec_t mask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    return _mm256_shuffle_epi8(a, mask);
+}
+
+inline vec_t vbswap32(vec_t a)
+{
+    const vec_t mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    return _mm256_shuffle_epi8(a, mask);
+}
+
+inline vec_t vbswap64(vec_t a)
+{
+    const vec_t mask = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    return _mm256_shuffle_epi8(a, mask);
+}
+
+#define BYTE_OPS_SIMD   1
+
+#elif defined(__SSE2__)
+
+using vec_t = __m128i;
+constexpr size_t VEC_SIZE = 16;
+
+inline vec_t load(const byte_t *p) { return _mm_loadu_si128(reinterpret_cast<const vec_t *>(p)); }
+inline void store(byte_t *p, vec_t v) { _mm_storeu_si128(reinterpret_cast<vec_t *>(p), v); }
+inline vec_t vxor(vec_t a, vec_t b) { return _mm_xor_si128(a, b); }
+inline vec_t vand(vec_t a, vec_t b) { return _mm_and_si128(a, b); }
+inline vec_t vor(vec_t a, vec_t b) { return _mm_or_si128(a, b); }
+inline vec_t vnot(vec_t a) { return _mm_xor_si128(a, _mm_set1_epi8(-1)); }
+
+/* SSE2没有字节重排指令，先以16位为单位交换顺序，再交换每个16位内的两个字节 */
+inline vec_t vbswap16(vec_t a)
+{
+    return _mm_or_si128(_mm_slli_epi16(a, 8), _mm_srli_epi16(a, 8));
+}
+
+inline vec_t vbswap32(vec_t a)
+{
+    a = _mm_shufflelo_epi16(a, _MM_SHUFFLE(2, 3, 0, 1));
+    a = _mm_shufflehi_epi16(a, _MM_SHUFFLE(2, 3, 0, 1));
+    return vbswap16(a);
+}
+
+inline vec_t vbswap64(vec_t a)
+{
+    a = _mm_shufflelo_epi16(a, _MM_SHUFFLE(0, 1, 2, 3));
+    a = _mm_shufflehi_epi16(a, _MM_SHUFFLE(0, 1, 2, 3));
+    return vbswap16(a);
+}
+
+#define BYTE_OPS_SIMD   1
+
+#else
+
+constexpr size_t VEC_SIZE = 16;
+
+#define BYTE_OPS_SIMD   0
+
+#endif
+
+/**
+ * @brief 计算需要逐元素处理的头部长度，使dst + head按向量宽度对齐
+ *
+ * @param elem 元素大小，头部长度为其整数倍；dst无法通过整元素对齐时返回0
+ */
+inline size_t alignHead(const byte_t *dst, size_t len, size_t elem)
+{
+    size_t head = (VEC_SIZE - reinterpret_cast<uintptr_t>(dst) % VEC_SIZE) % VEC_SIZE;
+
+    if (head % elem != 0)
+        return 0;
+    return head < len ? head : len / elem * elem;
+}
+
+/**
+ * @brief 逐字节二元运算的通用框架
+ */
+template <typename ScalarOp, typename VecOp>
+inline void binaryOp(byte_t *dst, const byte_t *a, const byte_t *b, size_t len, ScalarOp scalarOp, VecOp vecOp)
+{
+    size_t i = 0;
+
+#if BYTE_OPS_SIMD
+    for (size_t head = alignHead(dst, len, 1); i < head; i++)
+        dst[i] = scalarOp(a[i], b[i]);
+    for (; i + VEC_SIZE <= len; i += VEC_SIZE)
+        store(dst + i, vecOp(load(a + i), load(b + i)));
+#else
+    (void)vecOp;
+#endif
+    for (; i < len; i++)
+        dst[i] = scalarOp(a[i], b[i]);
+}
+
+/**
+ * @brief 字节序反转的通用框架，只处理完整的元素，剩余不足一个元素的字节原样复制
+ */
+template <size_t Elem, typename VecOp>
+inline void byteSwap(byte_t *dst, const byte_t *src, size_t len, VecOp vecOp)
+{
+    size_t i = 0;
+    size_t end = len / Elem * Elem;
+    byte_t temp[Elem];
+
+#if BYTE_OPS_SIMD
+    for (size_t head = alignHead(dst, end, Elem); i < head; i += Elem)
+    {
+        for (size_t k = 0; k < Elem; k++)
+            temp[k] = src[i + Elem - 1 - k];
+        memcpy(dst + i, temp, Elem);
+    }
+    for (; i + VEC_SIZE <= end; i += VEC_SIZE)
+        store(dst + i, vecOp(load(src + i)));
+#else
+    (void)vecOp;
+#endif
+    for (; i < end; i += Elem)
+    {
+        for (size_t k = 0; k < Elem; k++)
+            temp[k] = src[i + Elem - 1 - k];
+        memcpy(dst + i, temp, Elem);
+    }
+    if (dst != src && end < len)
+        memcpy(dst + end, src + end, len - end);
+}
+
+}   /* namespace detail */
+
+/**
+ * @brief dst = a ^ b
+ */
+inline void xorBytes(byte_t *dst, const byte_t *a, const byte_t *b, size_t len)
+{
+#if BYTE_OPS_SIMD
+    detail::binaryOp(dst, a, b, len, [](byte_t x, byte_t y) { return (byte_t)(x ^ y); }, detail::vxor);
+#else
+    detail::binaryOp(dst, a, b, len, [](byte_t x, byte_t y) { return (byte_t)(x ^ y); }, 0);
+#endif
+}
+
+/**
+ * @brief dst = a & b
+ */
+inline void andBytes(byte_t *dst, const byte_t *a, const byte_t *b, size_t len)
+{
+#if BYTE_OPS_SIMD
+    detail::binaryOp(dst, a, b, len, [](byte_t x, byte_t y) { return (byte_t)(x & y); }, detail::vand);
+#else
+    detail::binaryOp(dst, a, b, len, [](byte_t x, byte_t y) { return (byte_t)(x & y); }, 0);
+#endif
+}
+
+/**
+ * @brief dst = a | b
+ */
+inline void orBytes(byte_t *dst, const byte_t *a, const byte_t *b, size_t len)
+{
+#if BYTE_OPS_SIMD
+    detail::binaryOp(dst, a, b, len, [](byte_t x, byte_t y) { return (byte_t)(x | y); }, detail::vor);
+#else
+    detail::binaryOp(dst, a, b, len, [](byte_t x, byte_t y) { return (byte_t)(x | y); }, 0);
+#endif
+}
+
+/**
+ * @brief dst = ~src
+ */
+inline void notBytes(byte_t *dst, const byte_t *src, size_t len)
+{
+#if BYTE_OPS_SIMD
+    detail::binaryOp(dst, src, src, len, [](byte_t x, byte_t) { return (byte_t)~x; },
+                     [](detail::vec_t x, detail::vec_t) { return detail::vnot(x); });
+#else
+    detail::binaryOp(dst, src, src, len, [](byte_t x, byte_t) { return (byte_t)~x; }, 0);
+#endif
+}
+
+/**
+ * @brief dst = src ^ 重复的key，如WebSocket的4字节掩码
+ *
+ * @param keyOffset src[0]对应的key下标，用于分段处理同一数据流
+ */
+inline void xorRepeat(byte_t *dst, const byte_t *src, size_t len, const byte_t *key, size_t keyLen, size_t keyOffset = 0)
+{
+    if (keyLen == 0 || len == 0)
+        return;
+
+    /**
+     * 展开为 keyLen + VEC_SIZE 字节的模式串：pattern[i] = key[(keyOffset + i) % keyLen]，
+     * 则从任意相位 p 开始的一个向量宽度的掩码就是 pattern + p，处理完一个向量后相位前进 VEC_SIZE % keyLen。
+     */
+    byte_t small[64 + detail::VEC_SIZE];
+    std::vector<byte_t> large;
+    byte_t *pattern = small;
+    size_t phase = 0;
+    size_t i = 0;
+
+    if (keyLen > 64)
+    {
+        large.resize(keyLen + detail::VEC_SIZE);
+        pattern = large.data();
+    }
+    for (size_t k = 0; k < keyLen + detail::VEC_SIZE; k++)
+        pattern[k] = key[(keyOffset + k) % keyLen];
+
+#if BYTE_OPS_SIMD
+    for (size_t head = detail::alignHead(dst, len, 1); i < head; i++)
+        dst[i] = src[i] ^ pattern[i % keyLen];
+    phase = i % keyLen;
+    for (; i + detail::VEC_SIZE <= len; i += detail::VEC_SIZE)
+    {
+        detail::store(dst + i, detail::vxor(detail::load(src + i), detail::load(pattern + phase)));
+        phase += detail::VEC_SIZE % keyLen;
+        if (phase >= keyLen)
+            phase -= keyLen;
+    }
+#endif
+    for (; i < len; i++)
+    {
+        dst[i] = src[i] ^ pattern[phase];
+        if (++phase == keyLen)
+            phase = 0;
+    }
+}
+
+/**
+ * @brief 以16位为单位反转字节序，末尾不足一个元素的字节原样保留
+ */
+inline void byteSwap16(byte_t *dst, const byte_t *src, size_t len)
+{
+#if BYTE_OPS_SIMD
+    detail::byteSwap<2>(dst, src, len, detail::vbswap16);
+#else
+    detail::byteSwap<2>(dst, src, len, 0);
+#endif
+}
+
+/**
+ * @brief 以32位为单位反转字节序，末尾不足一个元素的字节原样保留
+ */
+inline void byteSwap32(byte_t *dst, const byte_t *src, size_t len)
+{
+#if BYTE_OPS_SIMD
+    detail::byteSwap<4>(dst, src, len, detail::vbswap32);
+#else
+    detail::byteSwap<4>(dst, src, len, 0);
+#endif
+}
+
+/**
+ * @brief 以64位为单位反转字节序，末尾不足一个元素的字节原样保留
+ */
+inline void byteSwap64(byte_t *dst, const byte_t *src, size_t len)
+{
+#if BYTE_OPS_SIMD
+    detail::byteSwap<8>(dst, src, len, detail::vbswap64);
+#else
+    detail::byteSwap<8>(dst, src, len, 0);
+#endif
+}
+
+/**
+ * @brief dst[i] = table[src[i]]
+ *
+ * SSE2/AVX2没有256项的字节查表指令，这里按8字节展开以减少循环开销并让多个查表并行。
+ */
+inline void translate(byte_t *dst, const byte_t *src, size_t len, const byte_t table[256])
+{
+    size_t i = 0;
+
+    for (; i + 8 <= len; i += 8)
+    {
+        byte_t t0 = table[src[i]], t1 = table[src[i + 1]], t2 = table[src[i + 2]], t3 = table[src[i + 3]];
+        byte_t t4 = table[src[i + 4]], t5 = table[src[i + 5]], t6 = table[src[i + 6]], t7 = table[src[i + 7]];
+        dst[i] = t0; dst[i + 1] = t1; dst[i + 2] = t2; dst[i + 3] = t3;
+        dst[i + 4] = t4; dst[i + 5] = t5; dst[i + 6] = t6; dst[i + 7] = t7;
+    }
+    for (; i < len; i++)
+        dst[i] = table[src[i]];
+}
+
+}   /* namespace ByteOps */
+
+
+#endif  /* BYTE_OPS_HPP */
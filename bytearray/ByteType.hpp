@@ -0,0 +1,11 @@
+#ifndef BYTE_TYPE_HPP
+#define BYTE_TYPE_HPP
+
+#if 1
+using byte_t = unsigned char;
+#else
+using byte_t = char;
+#endif
+
+
+#endif  /* BYTE_TYPE_HPP */
@@ -0,0 +1,359 @@
+/**
+ * Copyright (c) 2021-2026, Haier
+ *
+ * byte buffer for huge append-heavy workloads.
+ *
+ * ByteArray基于std::basic_string，每次扩容都要分配新缓冲区并拷贝全部数据，以0填充扩容时
+ * 页面还会被memset和随后的写入各访问一次。HugeByteArray容量小于HUGE_BYTE_ARRAY_MMAP_THRESHOLD
+ * 时使用malloc/realloc，超过后改用匿名mmap，扩容通过mremap(MREMAP_MAYMOVE)由内核移动页表，
+ * 不再拷贝数据。匿名映射的新页面内容为0，记录已知为0的区域后以0扩容时可跳过memset。
+ * 与std::basic_string一致，resize()/clear()缩小时保留容量，shrink_to_fit()才将内存归还系统。
+ * 位运算及base64原地解码与ByteArray共用ByteArrayOps。
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#ifndef HUGE_BYTE_ARRAY_HPP
+#define HUGE_BYTE_ARRAY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "ByteType.hpp"
+#include "ByteArray.hpp"
+#include "ByteArrayOps.hpp"
+
+/* 容量达到该值后改用匿名mmap */
+#ifndef HUGE_BYTE_ARRAY_MMAP_THRESHOLD
+#define HUGE_BYTE_ARRAY_MMAP_THRESHOLD  (1 << 20)
+#endif
+
+class HugeByteArray : public ByteArrayOps<HugeByteArray>
+{
+public:
+    using size_type = size_t;
+    using value_type = byte_t;
+    using iterator = byte_t *;
+    using const_iterator = const byte_t *;
+
+    /* 透明大页大小 */
+    static constexpr size_type HUGE_PAGE_SIZE = 2 << 20;
+
+    HugeByteArray() = default;
+    HugeByteArray(size_type size, byte_t byte = 0x00) { resize(size, byte); }
+    HugeByteArray(const byte_t *data, size_type size) { append(data, size); }
+    explicit HugeByteArray(const ByteArray &array) { append(array.data(), array.size()); }
+
+    HugeByteArray(const HugeByteArray &other) : hugePages_(other.hugePages_)
+    {
+        append(other.data_, other.size_);
+    }
+
+    HugeByteArray(HugeByteArray &&other) noexcept
+    {
+        swap(other);
+    }
+
+    HugeByteArray &operator=(HugeByteArray other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~HugeByteArray()
+    {
+        release();
+    }
+
+    void swap(HugeByteArray &other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(zeroFrom_, other.zeroFrom_);
+        std::swap(mapped_, other.mapped_);
+        std::swap(hugePages_, other.hugePages_);
+    }
+
+    /* 容器接口，与std::basic_string语义一致 @{ */
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+    byte_t *data() noexcept { return data_; }
+    const byte_t *data() const noexcept { return data_; }
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+    byte_t &operator[](size_type pos) noexcept { return data_[pos]; }
+    const byte_t &operator[](size_type pos) const noexcept { return data_[pos]; }
+
+    bool operator==(const HugeByteArray &other) const noexcept
+    {
+        return size_ == other.size_ && (size_ == 0 || memcmp(data_, other.data_, size_) == 0);
+    }
+
+    bool operator!=(const HugeByteArray &other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    HugeByteArray &append(const byte_t *data, size_type len)
+    {
+        /* 追加自身内容时扩容后重新定位 */
+        if (data >= data_ && data < data_ + size_)
+        {
+            size_type offset = data - data_;
+            grow(size_ + len);
+            data = data_ + offset;
+        }
+        else
+        {
+            grow(size_ + len);
+        }
+        if (len > 0)
+            memcpy(data_ + size_, data, len);
+        size_ += len;
+        zeroFrom_ = std::max(zeroFrom_, size_);
+        return *this;
+    }
+
+    HugeByteArray &append(const ByteArray &array)
+    {
+        return append(array.data(), array.size());
+    }
+
+    HugeByteArray &append(size_type count, byte_t byte)
+    {
+        resize(size_ + count, byte);
+        return *this;
+    }
+
+    void push_back(byte_t byte)
+    {
+        grow(size_ + 1);
+        data_[size_++] = byte;
+        zeroFrom_ = std::max(zeroFrom_, size_);
+    }
+
+    void resize(size_type size, byte_t byte = 0x00)
+    {
+        if (size > size_)
+        {
+            grow(size);
+            /* 以0扩容时只需清零曾经写过的部分 */
+            if (byte != 0x00)
+                memset(data_ + size_, byte, size - size_);
+            else if (zeroFrom_ > size_)
+                memset(data_ + size_, 0x00, std::min(size, zeroFrom_) - size_);
+            zeroFrom_ = std::max(zeroFrom_, size);
+        }
+        size_ = size;
+    }
+
+    void reserve(size_type capacity)
+    {
+        if (capacity > capacity_)
+            reallocate(capacity);
+    }
+
+    void clear() noexcept
+    {
+        size_ = 0;
+    }
+
+    void shrink_to_fit()
+    {
+        if (size_ == 0)
+            release();
+        else if (capacity_ > size_)
+            reallocate(size_);
+    }
+    /* 容器接口 @} */
+
+    /**
+     * @brief 是否已改用匿名mmap
+     */
+    bool isMapped() const noexcept
+    {
+        return mapped_;
+    }
+
+    /**
+     * @brief 设置是否使用透明大页，启用后映射区地址和容量按2MB对齐并标记MADV_HUGEPAGE，
+     *        从下次扩容开始生效（系统THP配置为never时无效）
+     */
+    void setHugePages(bool enable) noexcept
+    {
+        hugePages_ = enable;
+    }
+
+    /**
+     * @brief 拷贝为ByteArray
+     */
+    ByteArray toByteArray() const
+    {
+        return ByteArray(data_, size_);
+    }
+
+private:
+    byte_t *data_ = nullptr;
+    size_type size_ = 0;
+    size_type capacity_ = 0;
+    size_type zeroFrom_ = 0;    /* [zeroFrom_, capacity_)内容已知为0 */
+    bool mapped_ = false;
+    bool hugePages_ = false;
+
+    static size_type pageSize() noexcept
+    {
+        static const size_type size = sysconf(_SC_PAGESIZE);
+        return size;
+    }
+
+    static size_type alignUp(size_type n, size_type align) noexcept
+    {
+        return (n + align - 1) / align * align;
+    }
+
+    /**
+     * @brief 映射起始地址按align对齐的匿名内存，多映射align字节后释放首尾多余部分
+     *
+     * @return 失败返回MAP_FAILED
+     */
+    static void *mapAligned(size_type capacity, size_type align) noexcept
+    {
+        void *raw = mmap(nullptr, capacity + align, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+            return MAP_FAILED;
+
+        byte_t *head = static_cast<byte_t *>(raw);
+        byte_t *ptr = reinterpret_cast<byte_t *>(alignUp(reinterpret_cast<uintptr_t>(raw), align));
+        if (ptr > head)
+            munmap(head, ptr - head);
+        munmap(ptr + capacity, head + align - ptr);
+        return ptr;
+    }
+
+    /**
+     * @brief 调整映射区容量，启用透明大页时保持起始地址2MB对齐
+     *
+     * @return 失败返回MAP_FAILED
+     */
+    void *remap(size_type capacity) noexcept
+    {
+        if (!hugePages_)
+            return mremap(data_, capacity_, capacity, MREMAP_MAYMOVE);
+
+        /* 已对齐时优先原地调整，否则移动到新的对齐地址 */
+        if (reinterpret_cast<uintptr_t>(data_) % HUGE_PAGE_SIZE == 0)
+        {
+            void *ptr = mremap(data_, capacity_, capacity, 0);
+            if (ptr != MAP_FAILED)
+                return ptr;
+        }
+        void *ptr = mapAligned(capacity, HUGE_PAGE_SIZE);
+        if (ptr == MAP_FAILED)
+            return MAP_FAILED;
+        if (mremap(data_, capacity_, capacity, MREMAP_MAYMOVE | MREMAP_FIXED, ptr) == MAP_FAILED)
+        {
+            munmap(ptr, capacity);
+            return MAP_FAILED;
+        }
+        return ptr;
+    }
+
+    /**
+     * @brief 容量不足时按2倍扩容
+     */
+    void grow(size_type size)
+    {
+        if (size > capacity_)
+            reallocate(std::max(size, capacity_ * 2));
+    }
+
+    /**
+     * @brief 调整容量，capacity不小于size_
+     */
+    void reallocate(size_type capacity)
+    {
+        void *ptr;
+
+        if (capacity >= HUGE_BYTE_ARRAY_MMAP_THRESHOLD)
+        {
+            capacity = alignUp(capacity, hugePages_ ? HUGE_PAGE_SIZE : pageSize());
+            if (mapped_)
+            {
+                /* 内核移动页表，新增页面内容为0 */
+                ptr = remap(capacity);
+                if (ptr == MAP_FAILED)
+                    throw std::bad_alloc();
+                zeroFrom_ = std::min(zeroFrom_, capacity);
+            }
+            else
+            {
+                if (hugePages_)
+                    ptr = mapAligned(capacity, HUGE_PAGE_SIZE);
+                else
+                    ptr = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (ptr == MAP_FAILED)
+                    throw std::bad_alloc();
+                if (size_ > 0)
+                    memcpy(ptr, data_, size_);
+                free(data_);
+                zeroFrom_ = size_;
+            }
+            if (hugePages_)
+                madvise(ptr, capacity, MADV_HUGEPAGE);
+            mapped_ = true;
+        }
+        else
+        {
+            if (mapped_)
+            {
+                ptr = malloc(capacity);
+                if (ptr == nullptr)
+                    throw std::bad_alloc();
+                memcpy(ptr, data_, size_);
+                munmap(data_, capacity_);
+            }
+            else
+            {
+                ptr = realloc(data_, capacity);
+                if (ptr == nullptr)
+                    throw std::bad_alloc();
+            }
+            zeroFrom_ = capacity;
+            mapped_ = false;
+        }
+
+        data_ = static_cast<byte_t *>(ptr);
+        capacity_ = capacity;
+    }
+
+    /**
+     * @brief 释放全部内存
+     */
+    void release() noexcept
+    {
+        if (mapped_)
+            munmap(data_, capacity_);
+        else
+            free(data_);
+        data_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+        zeroFrom_ = 0;
+        mapped_ = false;
+    }
+};
+
+
+#endif  /* HUGE_BYTE_ARRAY_HPP */
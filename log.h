@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022, Haier
+ * Copyright (c) 2021-2026, Haier
  *
  * log util for unit test.
  *
@@ -26,13 +26,20 @@ extern "C" {
 #define LOG_GLOBAL_OUTPUT_LVL           LOG_LVL_VERBOSE
 #endif
 
-/* 日志输出函数实现 */
+/* 日志输出函数实现，定义LOG_RING_ENABLE时写入环形日志文件（需链接log_ring.c） */
 #include <stdio.h>
+#if defined(LOG_RING_ENABLE)
+#include "log_ring.h"
+#define log_printf(log_level, fmt, ...) log_ring_printf(log_level, fmt, ##__VA_ARGS__)
+#else
 #define log_printf(log_level, fmt, ...) printf(fmt, ##__VA_ARGS__)
+#endif
 #define log_output(log_level, fmt, ...) if (log_level <= LOG_GLOBAL_OUTPUT_LVL) log_printf(log_level, fmt, ##__VA_ARGS__)
 
-/* 日志颜色输出使能 */
-#ifndef LOG_COLOR_ENABLE
+/* 日志颜色输出使能，写入环形日志文件时关闭，避免文件中混入控制字符 */
+#if defined(LOG_RING_ENABLE)
+#undef LOG_COLOR_ENABLE
+#elif !defined(LOG_COLOR_ENABLE)
 #define LOG_COLOR_ENABLE
 #endif
 
@@ -148,7 +155,12 @@ static inline int64_t log_get_timestamp(void)
 #undef log_raw
 #undef assert
 
+#if defined(LOG_RING_ENABLE)
+/* 整行一次格式化，在环形日志文件中对应一条记录 */
+#define log_common(log_level, color, tag, fmt, ...)  { log_output(log_level, tag "[%lld] [func:%s] " fmt "\n", (long long)log_get_timestamp(), __FUNCTION__, ##__VA_ARGS__); }
+#else
 #define log_common(log_level, color, tag, fmt, ...)  { COLOR_START(log_level, color); log_output(log_level, tag "[%lld] [func:%s] " fmt, (long long)log_get_timestamp(), __FUNCTION__, ##__VA_ARGS__); COLOR_END(log_level); log_output(log_level, "\n"); }
+#endif
 
 #if LOG_LVL >= LOG_LVL_ASSERT
     #define log_a(fmt, ...)             log_common(LOG_LVL_ASSERT, LOG_COLOR_ASSERT, "[A] " "[" LOG_TAG "] ", fmt, ##__VA_ARGS__)
@@ -198,17 +210,20 @@ static inline int64_t log_get_timestamp(void)
     }
 
 /* assert definition for unit test */
-#define test_assert(expr)                                                   \
-    if (!(expr))                                                            \
+#define test_assert(expr)               test_assert_result((expr), #expr)
+
+/* output unit test result with the given expression string */
+#define test_assert_result(result, expr_str)                                \
+    if (!(result))                                                          \
     {                                                                       \
         COLOR_START(LOG_LVL_ASSERT, LOG_COLOR_TEST_ASSERT_FAILED);          \
-        log_output(LOG_LVL_ASSERT, "[Failed] (%s) assert failed at %s:%d.\n", #expr, __FUNCTION__, __LINE__); \
+        log_output(LOG_LVL_ASSERT, "[Failed] (%s) assert failed at %s:%d.\n", expr_str, __FUNCTION__, __LINE__); \
         COLOR_END(LOG_LVL_ASSERT);                                          \
     }                                                                       \
     else                                                                    \
     {                                                                       \
         COLOR_START(LOG_LVL_ASSERT, LOG_COLOR_TEST_ASSERT_PASSED);          \
-        log_output(LOG_LVL_ASSERT, "[Passed] (%s) assert passed at %s:%d.\n", #expr, __FUNCTION__, __LINE__); \
+        log_output(LOG_LVL_ASSERT, "[Passed] (%s) assert passed at %s:%d.\n", expr_str, __FUNCTION__, __LINE__); \
         COLOR_END(LOG_LVL_ASSERT);                                          \
     }
 
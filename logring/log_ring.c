@@ -0,0 +1,424 @@
+/**
+ * Copyright (c) 2021-2026, Haier
+ *
+ * crash-safe log sink backed by a memory-mapped ring file.
+ *
+ * 文件由64字节文件头和数据区组成，文件头记录数据区容量及读写游标。游标为单调递增的逻辑偏移，
+ * 对容量取模得到数据区内的位置，[tail, head)即为有效日志。每条记录由8字节记录头和日志内容组成，
+ * 按8字节对齐；数据区末尾放不下时写入填充记录，从数据区起始处继续写。空间不足时先推进tail
+ * 丢弃最旧的记录，再写内容和记录头，最后发布head。进程在任意位置崩溃，[tail, head)内的记录
+ * 都是完整的。
+ *
+ * 重新打开时以文件中的容量为准，请求的容量只用于新建文件，避免改变容量后丢失上次崩溃前的日志。
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#define LOG_TAG             "log_ring"
+#define LOG_LVL             LOG_LVL_INFO
+
+/* 本模块自身的日志不能写入环形日志文件 */
+#undef LOG_RING_ENABLE
+
+#include "log_ring.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "log.h"
+
+/*--- Defines/Macros/Types -------------------------------------------------------------------------*/
+
+#define LOG_RING_MAGIC                  0x474E524CU     /* "LRNG" */
+#define LOG_RING_VERSION                1
+
+/* 数据区最小容量 */
+#define LOG_RING_MIN_CAPACITY           256
+
+/* 记录类型 */
+#define LOG_RING_REC_DATA               1
+#define LOG_RING_REC_PAD                2
+
+/* 按8字节对齐 */
+#define LOG_RING_ALIGN(n)               (((n) + 7) & ~(uint64_t)7)
+
+/* 记录总长度（含记录头） */
+#define LOG_RING_REC_SIZE(len)          LOG_RING_ALIGN(sizeof(log_ring_rec_t) + (uint64_t)(len))
+
+/* 文件头 */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;          /* 数据区容量 */
+    uint64_t head;              /* 写游标（逻辑偏移） */
+    uint64_t tail;              /* 最旧记录的逻辑偏移 */
+    uint64_t count;             /* 累计写入的记录数 */
+    uint8_t reserved[24];
+} log_ring_hdr_t;
+
+/* 记录头 */
+typedef struct
+{
+    uint32_t len;               /* 日志内容长度 */
+    uint8_t type;               /* LOG_RING_REC_XXX */
+    uint8_t level;              /* 日志级别 */
+    uint16_t reserved;
+} log_ring_rec_t;
+
+/* 已打开的环形日志文件 */
+typedef struct
+{
+    log_ring_hdr_t *hdr;
+    uint8_t *data;
+    size_t map_size;
+    int flags;
+} log_ring_t;
+
+
+/*--- Prototypes -----------------------------------------------------------------------------------*/
+
+static int log_ring_hdr_valid(const log_ring_hdr_t *hdr, size_t file_size);
+static void log_ring_reserve(log_ring_t *ring, uint64_t size);
+static void log_ring_append(log_ring_t *ring, uint8_t type, uint8_t level, const char *data, uint32_t len);
+
+
+/*--- Variables ------------------------------------------------------------------------------------*/
+
+static log_ring_t log_ring = { NULL, NULL, 0, 0 };
+static pthread_mutex_t log_ring_lock = PTHREAD_MUTEX_INITIALIZER;
+
+
+/*--- Constants ------------------------------------------------------------------------------------*/
+
+
+/*--- Global Function Implementation ---------------------------------------------------------------*/
+
+int log_ring_open(const char *path, size_t capacity, int flags)
+{
+    char old_path[PATH_MAX];
+    log_ring_hdr_t old_hdr;
+    struct stat st;
+    size_t map_size;
+    void *map;
+    log_ring_hdr_t *hdr;
+    int fd;
+
+    if (path == NULL)
+        return -1;
+
+    log_ring_close();
+
+    if (capacity < LOG_RING_MIN_CAPACITY)
+        capacity = LOG_RING_MIN_CAPACITY;
+    capacity = LOG_RING_ALIGN(capacity);
+    map_size = sizeof(log_ring_hdr_t) + capacity;
+
+    fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+    {
+        log_e("Failed to open '%s'.", path);
+        return -1;
+    }
+    if (fstat(fd, &st) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    /* 已有文件长度与请求的容量不符 @{ */
+    if (st.st_size != 0 && (size_t)st.st_size != map_size && !(flags & LOG_RING_FLAG_TRUNCATE))
+    {
+        if (pread(fd, &old_hdr, sizeof(old_hdr), 0) == sizeof(old_hdr) && log_ring_hdr_valid(&old_hdr, st.st_size))
+        {
+            /* 沿用文件中的容量，保留已有日志 */
+            log_i("'%s' keeps its capacity %llu, requested %zu.", path, (unsigned long long)old_hdr.capacity, capacity);
+            capacity = old_hdr.capacity;
+            map_size = st.st_size;
+        }
+        else
+        {
+            /* 无法识别的文件改名保留，不直接清空 */
+            if (snprintf(old_path, sizeof(old_path), "%s.old", path) >= (int)sizeof(old_path)
+                || rename(path, old_path) != 0)
+            {
+                log_e("'%s' is not a log ring file and cannot be moved aside.", path);
+                close(fd);
+                return -1;
+            }
+            log_w("'%s' is not a log ring file, moved to '%s'.", path, old_path);
+            close(fd);
+            fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0)
+            {
+                log_e("Failed to open '%s'.", path);
+                return -1;
+            }
+            st.st_size = 0;
+        }
+    }
+    /* 已有文件长度与请求的容量不符 @} */
+
+    /* 新建或指定清空时按请求的容量重建，预先分配磁盘空间，避免写映射内存时因磁盘满触发SIGBUS */
+    if ((size_t)st.st_size != map_size)
+    {
+        if (ftruncate(fd, 0) < 0 || posix_fallocate(fd, 0, map_size) != 0)
+        {
+            log_e("Failed to allocate %zu bytes for '%s'.", map_size, path);
+            close(fd);
+            return -1;
+        }
+    }
+
+    map = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        log_e("Failed to map '%s'.", path);
+        return -1;
+    }
+
+    hdr = (log_ring_hdr_t *)map;
+    if ((flags & LOG_RING_FLAG_TRUNCATE) || !log_ring_hdr_valid(hdr, map_size))
+    {
+        memset(hdr, 0, sizeof(*hdr));
+        hdr->magic = LOG_RING_MAGIC;
+        hdr->version = LOG_RING_VERSION;
+        hdr->capacity = capacity;
+    }
+
+    pthread_mutex_lock(&log_ring_lock);
+    log_ring.data = (uint8_t *)map + sizeof(log_ring_hdr_t);
+    log_ring.map_size = map_size;
+    log_ring.flags = flags;
+    __atomic_store_n(&log_ring.hdr, hdr, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&log_ring_lock);
+
+    return 0;
+}
+
+void log_ring_close(void)
+{
+    pthread_mutex_lock(&log_ring_lock);
+    if (log_ring.hdr != NULL)
+        munmap(log_ring.hdr, log_ring.map_size);
+    __atomic_store_n(&log_ring.hdr, NULL, __ATOMIC_RELEASE);
+    log_ring.data = NULL;
+    log_ring.map_size = 0;
+    log_ring.flags = 0;
+    pthread_mutex_unlock(&log_ring_lock);
+}
+
+int log_ring_write(int log_level, const char *data, size_t len)
+{
+    uint64_t max_len;
+
+    if (data == NULL)
+        return -1;
+
+    pthread_mutex_lock(&log_ring_lock);
+    if (log_ring.hdr == NULL)
+    {
+        pthread_mutex_unlock(&log_ring_lock);
+        return -1;
+    }
+
+    /* 单条记录不超过容量的一半，保证写入时最多丢弃已有记录而不会覆盖自身 */
+    max_len = log_ring.hdr->capacity / 2 - sizeof(log_ring_rec_t);
+    if (len > max_len)
+        len = max_len;
+
+    log_ring_append(&log_ring, LOG_RING_REC_DATA, (uint8_t)log_level, data, (uint32_t)len);
+    if (log_ring.flags & LOG_RING_FLAG_TEE)
+        fwrite(data, 1, len, stdout);
+    pthread_mutex_unlock(&log_ring_lock);
+
+    return (int)len;
+}
+
+int log_ring_printf(int log_level, const char *fmt, ...)
+{
+    char line[LOG_RING_LINE_MAX];
+    va_list args;
+    int len;
+
+    /* 未打开时直接输出到stdout；与打开/关闭并发时由log_ring_write()在锁内再次判断 */
+    va_start(args, fmt);
+    if (__atomic_load_n(&log_ring.hdr, __ATOMIC_ACQUIRE) == NULL)
+    {
+        len = vprintf(fmt, args);
+        va_end(args);
+        return len;
+    }
+    len = vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+
+    if (len < 0)
+        return len;
+    if ((size_t)len >= sizeof(line))
+        len = sizeof(line) - 1;
+    if (log_ring_write(log_level, line, len) < 0)
+        return printf("%s", line);
+
+    return len;
+}
+
+int log_ring_sync(void)
+{
+    int ret = -1;
+
+    pthread_mutex_lock(&log_ring_lock);
+    if (log_ring.hdr != NULL)
+        ret = msync(log_ring.hdr, log_ring.map_size, MS_SYNC);
+    pthread_mutex_unlock(&log_ring_lock);
+
+    return ret;
+}
+
+int log_ring_dump(const char *path, FILE *out)
+{
+    const log_ring_hdr_t *hdr;
+    const log_ring_rec_t *rec;
+    const uint8_t *data;
+    struct stat st;
+    uint64_t pos, head, size;
+    void *map;
+    int count = 0;
+    int fd;
+
+    if (path == NULL || out == NULL)
+        return -1;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(log_ring_hdr_t))
+    {
+        close(fd);
+        return -1;
+    }
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return -1;
+
+    hdr = (const log_ring_hdr_t *)map;
+    if (!log_ring_hdr_valid(hdr, st.st_size))
+    {
+        munmap(map, st.st_size);
+        return -1;
+    }
+
+    data = (const uint8_t *)map + sizeof(log_ring_hdr_t);
+    head = __atomic_load_n(&hdr->head, __ATOMIC_ACQUIRE);
+    for (pos = __atomic_load_n(&hdr->tail, __ATOMIC_ACQUIRE); pos < head; pos += size)
+    {
+        /* 记录不会跨越数据区末尾，越界说明文件已损坏 */
+        rec = (const log_ring_rec_t *)(data + pos % hdr->capacity);
+        size = LOG_RING_REC_SIZE(rec->len);
+        if (size > hdr->capacity - pos % hdr->capacity || size > head - pos)
+            break;
+
+        if (rec->type == LOG_RING_REC_DATA)
+        {
+            fwrite(rec + 1, 1, rec->len, out);
+            count++;
+        }
+    }
+
+    munmap(map, st.st_size);
+
+    return count;
+}
+
+
+/*--- Local Function Implementation ----------------------------------------------------------------*/
+
+/**
+ * @brief 检查文件头是否有效
+ */
+static int log_ring_hdr_valid(const log_ring_hdr_t *hdr, size_t file_size)
+{
+    return hdr->magic == LOG_RING_MAGIC
+        && hdr->version == LOG_RING_VERSION
+        && hdr->capacity == file_size - sizeof(log_ring_hdr_t)
+        && hdr->capacity % 8 == 0
+        && hdr->head % 8 == 0
+        && hdr->tail % 8 == 0
+        && hdr->tail <= hdr->head
+        && hdr->head - hdr->tail <= hdr->capacity;
+}
+
+/**
+ * @brief 丢弃最旧的记录，直到数据区能放下size字节
+ */
+static void log_ring_reserve(log_ring_t *ring, uint64_t size)
+{
+    log_ring_hdr_t *hdr = ring->hdr;
+    const log_ring_rec_t *rec;
+    uint64_t tail = hdr->tail;
+    uint64_t rec_size;
+
+    while (hdr->head + size - tail > hdr->capacity)
+    {
+        rec = (const log_ring_rec_t *)(ring->data + tail % hdr->capacity);
+        rec_size = LOG_RING_REC_SIZE(rec->len);
+        if (rec_size > hdr->capacity - tail % hdr->capacity || rec_size > hdr->head - tail)
+        {
+            /* 记录已损坏，丢弃全部记录 */
+            tail = hdr->head;
+            break;
+        }
+        tail += rec_size;
+    }
+
+    /* 先发布tail再覆盖数据，崩溃时读者不会读到写了一半的旧记录 */
+    __atomic_store_n(&hdr->tail, tail, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 追加一条记录，调用者需持有锁
+ */
+static void log_ring_append(log_ring_t *ring, uint8_t type, uint8_t level, const char *data, uint32_t len)
+{
+    log_ring_hdr_t *hdr = ring->hdr;
+    log_ring_rec_t *rec;
+    uint64_t size = LOG_RING_REC_SIZE(len);
+    uint64_t pos = hdr->head % hdr->capacity;
+    uint64_t pad;
+
+    /* 数据区末尾放不下时填充到末尾，记录头为8字节，填充记录总能放下 */
+    if (pos + size > hdr->capacity)
+    {
+        pad = hdr->capacity - pos;
+        log_ring_reserve(ring, pad);
+        rec = (log_ring_rec_t *)(ring->data + pos);
+        rec->len = (uint32_t)(pad - sizeof(log_ring_rec_t));
+        rec->type = LOG_RING_REC_PAD;
+        rec->level = 0;
+        rec->reserved = 0;
+        __atomic_store_n(&hdr->head, hdr->head + pad, __ATOMIC_RELEASE);
+        pos = 0;
+    }
+
+    /* @{ 先写内容和记录头，最后发布head */
+    log_ring_reserve(ring, size);
+    rec = (log_ring_rec_t *)(ring->data + pos);
+    memcpy(rec + 1, data, len);
+    rec->len = len;
+    rec->type = type;
+    rec->level = level;
+    rec->reserved = 0;
+    hdr->count++;
+    __atomic_store_n(&hdr->head, hdr->head + size, __ATOMIC_RELEASE);
+    /* @} */
+}
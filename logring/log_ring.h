@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2021-2026, Haier
+ *
+ * crash-safe log sink backed by a memory-mapped ring file.
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--- Defines/Macros/Types -------------------------------------------------------------------------*/
+
+/* 打开标志 */
+#define LOG_RING_FLAG_TEE               0x01    /* 同时输出到stdout */
+#define LOG_RING_FLAG_TRUNCATE          0x02    /* 清空已有日志，否则接着上次的内容追加 */
+
+/* 单条日志最大长度，超出部分截断 */
+#ifndef LOG_RING_LINE_MAX
+#define LOG_RING_LINE_MAX               1024
+#endif
+
+
+/*--- Global Variables -----------------------------------------------------------------------------*/
+
+
+/*--- Global Constants -----------------------------------------------------------------------------*/
+
+
+/*--- Global Prototypes ----------------------------------------------------------------------------*/
+
+/**
+ * @brief 打开环形日志文件
+ *
+ * 文件映射到内存后，写日志只是内存拷贝，没有系统调用。进程崩溃时已写入的内容仍在内核页缓存中，
+ * 会正常落盘，可用logring/log_ring_dump.c（make tools）按顺序导出。
+ *
+ * 已有文件的文件头有效时沿用其容量，capacity只在新建或指定LOG_RING_FLAG_TRUNCATE时生效；
+ * 长度不符且无法识别的文件改名为"<path>.old"后重建。
+ *
+ * 注意：同一文件只能由一个进程写入。写入由进程内的互斥锁保护，多个进程同时打开同一文件会
+ * 互相覆盖游标而损坏日志。
+ *
+ * @param path 日志文件路径
+ * @param capacity 新建文件时数据区容量（字节），向上取整到8的倍数
+ * @param flags LOG_RING_FLAG_XXX
+ * @return 成功返回0，失败返回<0
+ */
+int log_ring_open(const char *path, size_t capacity, int flags);
+
+/**
+ * @brief 关闭环形日志文件
+ */
+void log_ring_close(void);
+
+/**
+ * @brief 写入一条日志
+ *
+ * @param log_level 日志级别
+ * @param data 日志内容
+ * @param len 日志长度
+ * @return 成功返回写入的长度，未打开或失败返回<0
+ */
+int log_ring_write(int log_level, const char *data, size_t len);
+
+/**
+ * @brief 格式化写入一条日志，未打开环形日志文件时输出到stdout
+ *
+ * 定义LOG_RING_ENABLE时log.h的log_printf()即为本函数，log_x()每行日志只调用一次，对应一条记录。
+ *
+ * @param log_level 日志级别
+ * @param fmt 格式字符串
+ * @return 格式化后的长度
+ */
+int log_ring_printf(int log_level, const char *fmt, ...);
+
+/**
+ * @brief 将已写入的内容同步到磁盘（仅掉电保护需要，进程崩溃无需调用）
+ *
+ * @return 成功返回0，失败返回<0
+ */
+int log_ring_sync(void);
+
+/**
+ * @brief 按写入顺序导出环形日志文件中的全部日志
+ *
+ * @param path 日志文件路径
+ * @param out 输出流
+ * @return 成功返回导出的日志条数，失败返回<0
+ */
+int log_ring_dump(const char *path, FILE *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOG_RING_H */
@@ -0,0 +1,34 @@
+/**
+ * Copyright (c) 2021-2026, Haier
+ *
+ * dump a log ring file in write order.
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#include <stdio.h>
+#include "log_ring.h"
+
+int main(int argc, char *argv[])
+{
+    int i;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <log_ring_file>...\n", argv[0]);
+        return 1;
+    }
+
+    for (i = 1; i < argc; i++)
+    {
+        if (log_ring_dump(argv[i], stdout) < 0)
+        {
+            fprintf(stderr, "%s: invalid log ring file.\n", argv[i]);
+            return 1;
+        }
+    }
+
+    return 0;
+}
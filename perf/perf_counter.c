@@ -0,0 +1,241 @@
+/**
+ * Copyright (c) 2021-2026, Haier
+ *
+ * hardware performance counters for unit test and benchmark.
+ *
+ * 基于Linux perf_event_open实现。所有计数器放在同一个事件组内，由组长统一开关、一次read读出，
+ * 保证各计数值对应同一段代码区域。计数器数量超过PMU容量时内核会分时复用，读出的值按
+ * time_enabled/time_running比例校正。
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#define LOG_TAG             "perf"
+#define LOG_LVL             LOG_LVL_INFO
+
+#include "perf_counter.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "log.h"
+
+/*--- Defines/Macros/Types -------------------------------------------------------------------------*/
+
+/* 组读取格式：PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING */
+struct perf_group_read
+{
+    uint64_t nr;
+    uint64_t time_enabled;
+    uint64_t time_running;
+    struct
+    {
+        uint64_t value;
+        uint64_t id;
+    } cnt[PERF_COUNTER_NUM];
+};
+
+/* 缓存事件编码 */
+#define PERF_CACHE_CONFIG(cache, op, result)    ((cache) | ((op) << 8) | ((result) << 16))
+
+
+/*--- Prototypes -----------------------------------------------------------------------------------*/
+
+static int perf_event_open(struct perf_event_attr *attr, int group_fd);
+static uint64_t perf_get_time_ns(void);
+
+
+/*--- Variables ------------------------------------------------------------------------------------*/
+
+
+/*--- Constants ------------------------------------------------------------------------------------*/
+
+/* 各计数器对应的事件 */
+static const struct
+{
+    uint32_t type;
+    uint64_t config;
+} perf_events[PERF_COUNTER_NUM] =
+{
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { PERF_TYPE_HW_CACHE, PERF_CACHE_CONFIG(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+};
+
+
+/*--- Global Function Implementation ---------------------------------------------------------------*/
+
+int perf_counter_open(perf_counter_t *pc)
+{
+    struct perf_event_attr attr;
+    int count = 0;
+    int i;
+
+    if (pc == NULL)
+        return -1;
+
+    memset(pc, 0, sizeof(*pc));
+    pc->leader = -1;
+
+    for (i = 0; i < PERF_COUNTER_NUM; i++)
+    {
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = perf_events[i].type;
+        attr.config = perf_events[i].config;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID
+                         | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.disabled = (pc->leader < 0) ? 1 : 0;   /* 组员跟随组长开关 */
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        pc->fd[i] = perf_event_open(&attr, pc->leader);
+        if (pc->fd[i] < 0)
+        {
+            log_d("counter %d unavailable.", i);
+            continue;
+        }
+        if (ioctl(pc->fd[i], PERF_EVENT_IOC_ID, &pc->id[i]) < 0)
+        {
+            close(pc->fd[i]);
+            pc->fd[i] = -1;
+            continue;
+        }
+        if (pc->leader < 0)
+            pc->leader = pc->fd[i];
+        count++;
+    }
+
+    if (count == 0)
+        log_w("Hardware counters unavailable, only elapsed time will be reported.");
+
+    return count;
+}
+
+void perf_counter_close(perf_counter_t *pc)
+{
+    int i;
+
+    if (pc == NULL)
+        return;
+
+    /* 先关闭组员，最后关闭组长 */
+    for (i = PERF_COUNTER_NUM - 1; i >= 0; i--)
+    {
+        if (pc->fd[i] >= 0 && pc->fd[i] != pc->leader)
+            close(pc->fd[i]);
+        pc->fd[i] = -1;
+    }
+    if (pc->leader >= 0)
+        close(pc->leader);
+    pc->leader = -1;
+}
+
+void perf_counter_start(perf_counter_t *pc)
+{
+    if (pc == NULL)
+        return;
+
+    memset(pc->valid, 0, sizeof(pc->valid));
+    if (pc->leader >= 0)
+    {
+        ioctl(pc->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(pc->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    pc->start_ns = perf_get_time_ns();
+}
+
+int perf_counter_stop(perf_counter_t *pc)
+{
+    struct perf_group_read data;
+    double scale;
+    uint64_t i, j;
+
+    if (pc == NULL)
+        return -1;
+
+    if (pc->leader >= 0)
+        ioctl(pc->leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    pc->elapsed_ns = perf_get_time_ns() - pc->start_ns;
+
+    if (pc->leader < 0)
+        return -1;
+    if (read(pc->leader, &data, sizeof(data)) < (ssize_t)(3 * sizeof(uint64_t)))
+        return -1;
+    if (data.time_running == 0)
+        return -1;
+
+    /* 计数器被分时复用时按运行时间比例校正 */
+    scale = (double)data.time_enabled / (double)data.time_running;
+
+    for (i = 0; i < data.nr && i < PERF_COUNTER_NUM; i++)
+    {
+        for (j = 0; j < PERF_COUNTER_NUM; j++)
+        {
+            if (pc->fd[j] >= 0 && pc->id[j] == data.cnt[i].id)
+            {
+                pc->value[j] = (uint64_t)(data.cnt[i].value * scale);
+                pc->valid[j] = 1;
+                break;
+            }
+        }
+    }
+
+    return 0;
+}
+
+void perf_counter_report(const perf_counter_t *pc, const char *name, size_t bytes)
+{
+    char line[256];
+    int len = 0;
+
+    if (pc == NULL)
+        return;
+
+    len += snprintf(line + len, sizeof(line) - len, "    [perf] %s%s%.3f ms",
+                    name ? name : "", name ? ": " : "", pc->elapsed_ns / 1e6);
+    if (bytes > 0 && pc->elapsed_ns > 0)
+        len += snprintf(line + len, sizeof(line) - len, ", %.1f MB/s", bytes * 1e3 / pc->elapsed_ns);
+
+    if (pc->valid[PERF_COUNTER_CYCLES] && pc->valid[PERF_COUNTER_INSTRUCTIONS] && pc->value[PERF_COUNTER_CYCLES] > 0)
+        len += snprintf(line + len, sizeof(line) - len, ", IPC %.2f",
+                        (double)pc->value[PERF_COUNTER_INSTRUCTIONS] / pc->value[PERF_COUNTER_CYCLES]);
+    if (pc->valid[PERF_COUNTER_BRANCH_MISSES])
+        len += snprintf(line + len, sizeof(line) - len, ", br-miss %llu",
+                        (unsigned long long)pc->value[PERF_COUNTER_BRANCH_MISSES]);
+    if (bytes > 0 && pc->valid[PERF_COUNTER_L1D_MISSES])
+        len += snprintf(line + len, sizeof(line) - len, ", L1D-miss/B %.4f",
+                        (double)pc->value[PERF_COUNTER_L1D_MISSES] / bytes);
+    if (bytes > 0 && pc->valid[PERF_COUNTER_LLC_MISSES])
+        len += snprintf(line + len, sizeof(line) - len, ", LLC-miss/B %.4f",
+                        (double)pc->value[PERF_COUNTER_LLC_MISSES] / bytes);
+    if (pc->leader < 0)
+        len += snprintf(line + len, sizeof(line) - len, " (counters unavailable)");
+
+    log_raw("%s\n", line);
+}
+
+
+/*--- Local Function Implementation ----------------------------------------------------------------*/
+
+static int perf_event_open(struct perf_event_attr *attr, int group_fd)
+{
+    /* pid = 0, cpu = -1：统计当前进程在任意CPU上的事件 */
+    return (int)syscall(SYS_perf_event_open, attr, 0, -1, group_fd, 0);
+}
+
+static uint64_t perf_get_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
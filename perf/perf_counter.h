@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2021-2026, Haier
+ *
+ * hardware performance counters for unit test and benchmark.
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#ifndef PERF_COUNTER_H
+#define PERF_COUNTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*--- Defines/Macros/Types -------------------------------------------------------------------------*/
+
+/* 计数器编号 */
+typedef enum
+{
+    PERF_COUNTER_CYCLES = 0,            /* CPU周期数 */
+    PERF_COUNTER_INSTRUCTIONS,          /* 指令数 */
+    PERF_COUNTER_BRANCH_MISSES,         /* 分支预测失败次数 */
+    PERF_COUNTER_L1D_MISSES,            /* L1数据缓存读缺失次数 */
+    PERF_COUNTER_LLC_MISSES,            /* 末级缓存缺失次数 */
+    PERF_COUNTER_NUM
+} perf_counter_id_t;
+
+/* 计数器组 */
+typedef struct
+{
+    int fd[PERF_COUNTER_NUM];           /* 各计数器的文件描述符，不可用时为-1 */
+    uint64_t id[PERF_COUNTER_NUM];      /* 各计数器在组内的ID */
+    int leader;                         /* 组长计数器的文件描述符，-1表示无可用计数器 */
+    uint64_t value[PERF_COUNTER_NUM];   /* 最近一次测量的计数值（已按复用比例校正） */
+    int valid[PERF_COUNTER_NUM];        /* 最近一次测量中各计数值是否有效 */
+    uint64_t elapsed_ns;                /* 最近一次测量的耗时，计数器不可用时同样有效 */
+    uint64_t start_ns;                  /* 测量起始时间 */
+} perf_counter_t;
+
+/**
+ * 统计一段代码区域的计数值，并在结束后输出报告
+ *
+ * 用法：
+ *     perf_counter_region(&pc, "encode", len)
+ *     {
+ *         base64_encode(...);
+ *     }
+ */
+#define perf_counter_region(pc, name, bytes)                                \
+    for (int _perf_once = (perf_counter_start(pc), 1); _perf_once;          \
+         _perf_once = 0, perf_counter_stop(pc), perf_counter_report(pc, name, bytes))
+
+/* 单个用例处理的数据量低于该值时，计数器开关本身的开销占主导，不输出报告 */
+#ifndef PERF_TEST_MIN_BYTES
+#define PERF_TEST_MIN_BYTES             (64 * 1024)
+#endif
+
+/**
+ * 带计数器统计的单元测试断言，在Passed/Failed结果后输出IPC及每字节缺失次数
+ *
+ * 只用于处理数据量不低于PERF_TEST_MIN_BYTES的用例，低于该值时等同于test_assert。
+ */
+#define perf_test_assert(pc, bytes, expr)                                   \
+    {                                                                       \
+        int _perf_result;                                                   \
+        size_t _perf_bytes = (bytes);                                       \
+        if (_perf_bytes < PERF_TEST_MIN_BYTES)                              \
+        {                                                                   \
+            test_assert_result((expr) ? 1 : 0, #expr);                      \
+        }                                                                   \
+        else                                                                \
+        {                                                                   \
+            perf_counter_start(pc);                                         \
+            _perf_result = (expr) ? 1 : 0;                                  \
+            perf_counter_stop(pc);                                          \
+            test_assert_result(_perf_result, #expr);                        \
+            perf_counter_report(pc, NULL, _perf_bytes);                     \
+        }                                                                   \
+    }
+
+
+/*--- Global Variables -----------------------------------------------------------------------------*/
+
+
+/*--- Global Constants -----------------------------------------------------------------------------*/
+
+
+/*--- Global Prototypes ----------------------------------------------------------------------------*/
+
+/**
+ * @brief 打开计数器组
+ *
+ * 仅统计当前进程的用户态事件。个别计数器打开失败时（如容器、虚拟机中）会被跳过，
+ * 全部失败时仍可正常调用其余接口，此时只统计耗时。
+ *
+ * @param pc 计数器组
+ * @return 成功打开的计数器个数，参数错误返回<0
+ */
+int perf_counter_open(perf_counter_t *pc);
+
+/**
+ * @brief 关闭计数器组
+ *
+ * @param pc 计数器组
+ */
+void perf_counter_close(perf_counter_t *pc);
+
+/**
+ * @brief 清零并开始计数
+ *
+ * @param pc 计数器组
+ */
+void perf_counter_start(perf_counter_t *pc);
+
+/**
+ * @brief 停止计数并读取计数值
+ *
+ * @param pc 计数器组
+ * @return 成功返回0，读取计数值失败返回<0（耗时仍有效）
+ */
+int perf_counter_stop(perf_counter_t *pc);
+
+/**
+ * @brief 输出最近一次测量的报告：耗时、IPC、分支预测失败及每字节缓存缺失次数
+ *
+ * @param pc 计数器组
+ * @param name 测量区域名称，可为NULL
+ * @param bytes 测量区域处理的字节数，为0时不输出每字节统计
+ */
+void perf_counter_report(const perf_counter_t *pc, const char *name, size_t bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERF_COUNTER_H */
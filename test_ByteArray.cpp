@@ -10,6 +10,8 @@
 
 #include "log.h"
 #include "ByteArray.hpp"
+#include "HugeByteArray.hpp"
+#include "perf_counter.h"
 #include <stdint.h>
 #include <string.h>
 
@@ -45,5 +47,95 @@ int main(int argc, char *argv[])
     array4 = "";
     test_assert(array4.size() == 1);
 
+    ByteArray array5("SGVsbG8sIHdvcmxkICE=");
+    test_assert(array5.decodeBase64InPlace() == (int)strlen("Hello, world !"));
+    test_assert(array5 == ByteArray(reinterpret_cast<const byte_t *>("Hello, world !"), strlen("Hello, world !")));
+    ByteArray array6("SGVs*G8=");
+    test_assert(array6.decodeBase64InPlace() == 3);
+
+    /* 位运算 */
+    const byte_t mask[4] = { 0x37, 0xfa, 0x21, 0x3d };
+    ByteArray frame(data + 1, sizeof(data) - 1);
+    ByteArray masked = frame.xorMasked(mask, sizeof(mask));
+    test_assert(masked.size() == frame.size() && masked[0] == (byte_t)(1 ^ 0x37) && masked[254] == (byte_t)(255 ^ 0x21));
+    test_assert(masked.xorMask(mask, sizeof(mask)) == frame);
+    test_assert(frame.xored(frame) == ByteArray(frame.size()));
+    test_assert(ByteArray(frame).invert() == frame.inverted() && frame.inverted()[0] == (byte_t)~1);
+    test_assert(frame.anded(frame.inverted()) == ByteArray(frame.size()));
+    test_assert(frame.ored(frame.inverted()) == ByteArray(frame.size(), 0xff));
+    test_assert(ByteArray(frame).xorWith(mask, sizeof(mask)).substr(4) == frame.substr(4));
+
+    ByteArray swapped = array.byteSwapped32();
+    test_assert(swapped[0] == 3 && swapped[3] == 0 && swapped[252] == 255 && swapped[255] == 252);
+    test_assert(ByteArray(swapped).byteSwap32() == array);
+    test_assert(frame.byteSwapped16()[0] == 2 && frame.byteSwapped16()[254] == 255);
+    test_assert(frame.byteSwapped64()[0] == 8 && frame.byteSwapped64()[7] == 1 && frame.byteSwapped64()[248] == 249);
+
+    byte_t table[256];
+    for (int i = 0; i < 256; i++)
+        table[i] = (byte_t)(255 - i);
+    test_assert(array.translated(table) == array.inverted());
+
+    /* 大缓冲区 */
+    HugeByteArray huge;
+    for (int i = 0; i < 64; i++)
+        huge.append(data, sizeof(data));
+    test_assert(huge.size() == 64 * sizeof(data) && !huge.isMapped());
+    while (huge.size() < 4 * HUGE_BYTE_ARRAY_MMAP_THRESHOLD)
+        huge.append(data, sizeof(data));
+    test_assert(huge.isMapped() && huge[huge.size() - 1] == 255 && memcmp(huge.data() + 4096, data, sizeof(data)) == 0);
+    huge.append(huge.data(), sizeof(data));
+    test_assert(memcmp(huge.end() - sizeof(data), data, sizeof(data)) == 0);
+    huge.resize(100);
+    huge.resize(2 * HUGE_BYTE_ARRAY_MMAP_THRESHOLD);
+    test_assert(huge[99] == 99 && std::all_of(huge.begin() + 100, huge.end(), [](byte_t b) { return b == 0; }));
+    huge.resize(3 * HUGE_BYTE_ARRAY_MMAP_THRESHOLD, 0xa5);
+    test_assert(huge[2 * HUGE_BYTE_ARRAY_MMAP_THRESHOLD] == 0xa5 && huge[huge.size() - 1] == 0xa5);
+    HugeByteArray hugeCopy(huge);
+    test_assert(hugeCopy == huge && hugeCopy.data() != huge.data());
+    huge.resize(HUGE_BYTE_ARRAY_MMAP_THRESHOLD + 1);
+    huge.shrink_to_fit();
+    test_assert(huge.isMapped() && huge.capacity() < 2 * HUGE_BYTE_ARRAY_MMAP_THRESHOLD);
+    huge.resize(100);
+    huge.shrink_to_fit();
+    test_assert(!huge.isMapped() && huge.toByteArray() == ByteArray(data, 100));
+    HugeByteArray hugeMoved(std::move(hugeCopy));
+    test_assert(hugeCopy.empty() && hugeMoved.size() == 3 * HUGE_BYTE_ARRAY_MMAP_THRESHOLD);
+    hugeMoved.clear();
+    hugeMoved.shrink_to_fit();
+    test_assert(hugeMoved.capacity() == 0 && !hugeMoved.isMapped());
+    HugeByteArray hugePages;
+    hugePages.setHugePages(true);
+    hugePages.resize(HUGE_BYTE_ARRAY_MMAP_THRESHOLD);
+    test_assert(hugePages.isMapped() && hugePages.capacity() % HugeByteArray::HUGE_PAGE_SIZE == 0);
+    test_assert(reinterpret_cast<uintptr_t>(hugePages.data()) % HugeByteArray::HUGE_PAGE_SIZE == 0);
+    hugePages[0] = 0x5a;
+    hugePages.resize(16 * HUGE_BYTE_ARRAY_MMAP_THRESHOLD);
+    test_assert(reinterpret_cast<uintptr_t>(hugePages.data()) % HugeByteArray::HUGE_PAGE_SIZE == 0 && hugePages[0] == 0x5a);
+
+    HugeByteArray hugeFrame(frame.data(), frame.size());
+    test_assert(hugeFrame.xorMasked(mask, sizeof(mask)).toByteArray() == frame.xorMasked(mask, sizeof(mask)));
+    test_assert(HugeByteArray(hugeFrame).xorMask(mask, sizeof(mask)).xorMask(mask, sizeof(mask)) == hugeFrame);
+    test_assert(hugeFrame.inverted().toByteArray() == frame.inverted() && hugeFrame.xored(hugeFrame) == HugeByteArray(frame.size()));
+    test_assert(hugeFrame.anded(hugeFrame.inverted()) == HugeByteArray(frame.size()));
+    test_assert(hugeFrame.ored(hugeFrame.inverted()) == HugeByteArray(frame.size(), 0xff));
+    test_assert(HugeByteArray(hugeFrame).xorWith(frame.inverted().data(), frame.size()) == HugeByteArray(frame.size(), 0xff));
+    test_assert(hugeFrame.byteSwapped16().toByteArray() == frame.byteSwapped16() && hugeFrame.byteSwapped64().toByteArray() == frame.byteSwapped64());
+    test_assert(HugeByteArray(array).byteSwap32().toByteArray() == swapped && HugeByteArray(array).translate(table).toByteArray() == array.inverted());
+    HugeByteArray hugeBase64(reinterpret_cast<const byte_t *>("SGVsbG8sIHdvcmxkICE="), strlen("SGVsbG8sIHdvcmxkICE="));
+    test_assert(hugeBase64.decodeBase64InPlace() == (int)strlen("Hello, world !"));
+    test_assert(hugeBase64.toByteArray() == ByteArray(reinterpret_cast<const byte_t *>("Hello, world !"), strlen("Hello, world !")));
+
+    perf_counter_t pc;
+    perf_counter_open(&pc);
+    perf_test_assert(&pc, 1 << 20, ByteArray(1 << 20, 0x5a).size() == (1 << 20));
+    ByteArray payload(1 << 20, 0x5a);
+    perf_test_assert(&pc, payload.size(), payload.xorMask(mask, sizeof(mask))[5] == (0x5a ^ 0xfa));
+    ByteArray appended;
+    perf_test_assert(&pc, 64 << 20, [&] { for (int i = 0; i < (64 << 20) / 256; i++) appended.append(data, sizeof(data)); return appended.size() == (64 << 20); }());
+    HugeByteArray hugeAppended;
+    perf_test_assert(&pc, 64 << 20, [&] { for (int i = 0; i < (64 << 20) / 256; i++) hugeAppended.append(data, sizeof(data)); return hugeAppended.size() == (64 << 20); }());
+    perf_counter_close(&pc);
+
     return 0;
 }
@@ -13,7 +13,16 @@
 
 #include "base64.h"
 #include "base64_ex.h"
+#include "base32.h"
+#include "base16.h"
+#include "base85.h"
+#include "base64_cache.h"
+#include "perf_counter.h"
 #include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include "log.h"
 
 static const uint8_t test_raw_data[] =
@@ -36,30 +45,283 @@ static const uint8_t test_raw_data[] =
     0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,     /* ASCII: 0x78 ~ 0x7f */
 };
 
+/* 带计数器报告的大数据量用例的数据长度 */
+#define TEST_PERF_DATA_SIZE             (1024 * 1024)
+
 static char base64_buf[calc_base64_buf_size(sizeof(test_raw_data))];
+static char base16_buf[calc_base16_buf_size(sizeof(test_raw_data))];
+static char base32_buf[calc_base32_buf_size(sizeof(test_raw_data))];
+static char base85_buf[calc_ascii85_buf_size(sizeof(test_raw_data))];
 static uint8_t raw_data_buf[sizeof(test_raw_data)];
 
 static const char *test_base64_img = "data:image/png;base64,iVBORw0KGgoAAAANSUhEUgAAAPoAAAD6AQAAAACgl2eQAAACuUlEQVR42u2ZwZFjIQxEIRGUfxYbCiQC26/B5W9v1d7QyS7P+BveQSOphcSU9f/Xn/IDfsAPuAT0UuqaJWasqYc69Dy8mAcMvVlorVS4VqLX4fU8gK8z9F2/Zml8q17MBcbqdbaAqDJZn/kAO1hYvF1iZQMESwv4aHWFrGjvn2jeBcjP8f36zurLAK9Ze3Gg5J8eS+8vdV8GetFukVr4rFZuk4paJAKKigTr/NBD2MZZZ6xEQOmqNKkIFmdRPWxmTQRkGEmjDVWQTvLIxLKtTAO01WUkCSNvYTDm9kzgVbdIGGVtcbD0nAlMS4aq1UvzgUI5f4g3AdiuehkJ5ex5F7EEYLCo44TS0S3ZcfInEVCKBH2FigZGBmr+EO99wBmDUhpnWRAmF9OaCSg84djQaiFeLR2XZQFO2N1gnL1C+RgjEwjLhALS4njsq4jdB4qPtOBYQbd997yPYn4fIE6dvntYQ5wu9Fsf4r0NdMVlnJgNqjpnPHpOBFywaPbQrs6WSnHfukkDdJArNIGIeRBGz/PsBhMA5aecI6x5nRLW41HEEgD5iOh4DPKh7lL+HAbvA93jl9doMx210uIt3gSAWWPrltRFNcxl8l0iQNk+89/0XIylrCUC9pWsk2Rormyze41EYJzuf55d+YgRYKQCaCY4XWm92242PaznAb6e0SGieK1Tzl43FmmAmqqdKczkuIgJ/aMrvg84XM7aecqIh7OxEoFTRvccinot3vb4KxKAEu61MdKXFVKuB6NEwJ3ecPNPhGi8CdV7EEsAdt9LnvqyiJw5Q0Ae0G0RSbPc7Vg7/CQCvh+jhBfbVmrfzd7KBHxJdS4PPRTv26OaDJCotJhcm+mgb/sGLRfYM6CdtK9IZouVCZAiTGG0Or67a7HnwzzgFA26TUK29iSyPrP6MvD7X9IP+AHpwF/KjfT2txe2jwAAAABJRU5ErkJggg==";
 
 
+static int file_equal(const char *path1, const char *path2)
+{
+    FILE *fp1 = fopen(path1, "rb");
+    FILE *fp2 = fopen(path2, "rb");
+    int c1 = 0, c2 = 0;
+
+    if (fp1 != NULL && fp2 != NULL)
+    {
+        do
+        {
+            c1 = fgetc(fp1);
+            c2 = fgetc(fp2);
+        } while (c1 == c2 && c1 != EOF);
+    }
+    if (fp1 != NULL)
+        fclose(fp1);
+    if (fp2 != NULL)
+        fclose(fp2);
+
+    return fp1 != NULL && fp2 != NULL && c1 == c2;
+}
+
 int main(int argc, char *argv[])
 {
     char *base64;
+    char *img_buf;
+    base64_cache_stats_t cache_stats;
+    struct stat file_stat;
+    perf_counter_t pc;
+
+    perf_counter_open(&pc);
 
     test_assert(base64_encode(test_raw_data, sizeof(test_raw_data), base64_buf, sizeof(base64_buf) - 3) == NULL)
 
-    base64 = base64_encode(test_raw_data, sizeof(test_raw_data), base64_buf, sizeof(base64_buf));
-    test_assert(base64 != NULL);
+    test_assert((base64 = base64_encode(test_raw_data, sizeof(test_raw_data), base64_buf, sizeof(base64_buf))) != NULL);
     log_d("base64: %s", base64);
 
     test_assert(base64_decode(base64, raw_data_buf, sizeof(raw_data_buf) - 1) == -1);
     test_assert(base64_decode(base64, raw_data_buf, sizeof(raw_data_buf)) == sizeof(test_raw_data));
     test_assert(memcmp(raw_data_buf, test_raw_data, sizeof(raw_data_buf)) == 0);
 
+    test_assert(strcmp(base64_encode("foob", 4, base64_buf, sizeof(base64_buf)), "Zm9vYg==") == 0);
+    test_assert(strcmp(base64_encode("fooba", 5, base64_buf, sizeof(base64_buf)), "Zm9vYmE=") == 0);
+    test_assert(strcmp(base64_encode("foobar", 6, base64_buf, sizeof(base64_buf)), "Zm9vYmFy") == 0);
+
+    /* 批量编解码 */
+    {
+        const void *records[3] = { "f", "fooba", "foobar" };
+        const size_t record_lens[3] = { 1, 5, 6 };
+        const char *base64_records[3];
+        size_t offsets[4];
+
+        test_assert(calc_base64_batch_buf_size(record_lens, 3) == 5 + 9 + 9);
+        test_assert(base64_encode_batch(records, record_lens, 3, base64_buf, 22, offsets) == NULL);
+        test_assert(base64_encode_batch(records, record_lens, 3, base64_buf, 23, offsets) == base64_buf);
+        test_assert(offsets[0] == 0 && offsets[1] == 5 && offsets[2] == 14 && offsets[3] == 23);
+        test_assert(strcmp(base64_buf + offsets[1], "Zm9vYmE=") == 0 && strcmp(base64_buf + offsets[2], "Zm9vYmFy") == 0);
+
+        for (int i = 0; i < 3; i++)
+            base64_records[i] = base64_buf + offsets[i];
+        test_assert(base64_decode_batch(base64_records, NULL, 3, raw_data_buf, 11, offsets) == -1);
+        test_assert(base64_decode_batch(base64_records, NULL, 3, raw_data_buf, 12, offsets) == 12);
+        test_assert(offsets[1] == 1 && offsets[2] == 6 && offsets[3] == 12 && memcmp(raw_data_buf, "ffoobafoobar", 12) == 0);
+    }
+
+    /* 批量编解码：多条数据拼接后跨向量处理，结果与逐条调用相同 */
+    {
+        const void *records[40];
+        size_t record_lens[40];
+        const char *base64_records[40];
+        size_t offsets[41];
+        char batch_base64[40 * calc_base64_buf_size(64)];
+        uint8_t batch_raw[40 * 64];
+        size_t i, pos;
+        int same = 1;
+
+        for (i = 0, pos = 0; i < 40; i++)
+        {
+            records[i] = test_raw_data + i;
+            record_lens[i] = i * 7 % 61;
+            pos += record_lens[i];
+        }
+        test_assert(base64_encode_batch(records, record_lens, 40, batch_base64, sizeof(batch_base64), offsets) == batch_base64);
+        for (i = 0; i < 40; i++)
+        {
+            same = same && strcmp(base64_encode(records[i], record_lens[i], base64_buf, sizeof(base64_buf)), batch_base64 + offsets[i]) == 0;
+            base64_records[i] = batch_base64 + offsets[i];
+        }
+        test_assert(same);
+        test_assert(base64_decode_batch(base64_records, NULL, 40, batch_raw, sizeof(batch_raw), offsets) == (int)pos);
+        for (i = 0; i < 40; i++)
+            same = same && offsets[i + 1] - offsets[i] == record_lens[i] && memcmp(batch_raw + offsets[i], records[i], record_lens[i]) == 0;
+        test_assert(same);
+
+        /* 第8条（56字节，76个字符）第10组含无效字符，只解码前9组，其余各条不受影响 */
+        batch_base64[base64_records[8] - batch_base64 + 37] = '*';
+        test_assert(base64_decode_batch(base64_records, NULL, 40, batch_raw, sizeof(batch_raw), offsets) == (int)(pos - 56 + 27));
+        test_assert(offsets[9] - offsets[8] == 27 && memcmp(batch_raw + offsets[8], records[8], 27) == 0);
+        test_assert(offsets[40] - offsets[39] == record_lens[39] && memcmp(batch_raw + offsets[39], records[39], record_lens[39]) == 0);
+    }
+
+    /* 原地解码 */
+    base64 = base64_encode(test_raw_data, sizeof(test_raw_data), base64_buf, sizeof(base64_buf));
+    test_assert(base64_decode_inplace(base64_buf, sizeof(base64_buf)) == sizeof(test_raw_data));
+    test_assert(memcmp(base64_buf, test_raw_data, sizeof(test_raw_data)) == 0);
+    base64 = base64_encode(test_raw_data, sizeof(test_raw_data) - 1, base64_buf, sizeof(base64_buf));
+    test_assert(base64_decode_inplace(base64_buf, strlen(base64_buf)) == sizeof(test_raw_data) - 1);
+    test_assert(memcmp(base64_buf, test_raw_data, sizeof(test_raw_data) - 1) == 0);
+    test_assert(base64_decode_inplace(NULL, 0) == -1);
+    test_assert(base64_decode_inplace(base64_buf, 0) == 0);
+
+    /* base16 */
+    test_assert(base16_encode(test_raw_data, sizeof(test_raw_data), base16_buf, sizeof(base16_buf) - 1) == NULL);
+    test_assert(base16_encode(test_raw_data, sizeof(test_raw_data), base16_buf, sizeof(base16_buf)) != NULL);
+    test_assert(strncmp(base16_buf, "FFFFFFFF", 8) == 0 && strlen(base16_buf) == sizeof(test_raw_data) * 2);
+    test_assert(base16_decode(base16_buf, raw_data_buf, sizeof(raw_data_buf)) == sizeof(test_raw_data));
+    test_assert(memcmp(raw_data_buf, test_raw_data, sizeof(test_raw_data)) == 0);
+    test_assert(strcmp(base16_encode("Hello", 5, base16_buf, sizeof(base16_buf)), "48656C6C6F") == 0);
+    test_assert(base16_decode("48656c6C6f", raw_data_buf, sizeof(raw_data_buf)) == 5 && memcmp(raw_data_buf, "Hello", 5) == 0);
+    test_assert(base16_decode("4865XX6C6F", raw_data_buf, sizeof(raw_data_buf)) == 2);
+
+    /* base32 */
+    test_assert(strcmp(base32_encode("foobar", 6, base32_buf, sizeof(base32_buf)), "MZXW6YTBOI======") == 0);
+    test_assert(strcmp(base32_encode("fooba", 5, base32_buf, sizeof(base32_buf)), "MZXW6YTB") == 0);
+    test_assert(strcmp(base32_encode("f", 1, base32_buf, sizeof(base32_buf)), "MY======") == 0);
+    test_assert(strcmp(base32hex_encode("foobar", 6, base32_buf, sizeof(base32_buf)), "CPNMUOJ1E8======") == 0);
+    test_assert(base32_decode("MZXW6YTBOI======", raw_data_buf, sizeof(raw_data_buf)) == 6 && memcmp(raw_data_buf, "foobar", 6) == 0);
+    test_assert(base32hex_decode("cpnmuoj1e8======", raw_data_buf, sizeof(raw_data_buf)) == 6 && memcmp(raw_data_buf, "foobar", 6) == 0);
+    test_assert(base32_decode("MZXW6YTBOI======", raw_data_buf, 5) == -1);
+    test_assert(base32_decode("MZXW6Y==", raw_data_buf, sizeof(raw_data_buf)) == -1);
+    test_assert(base32_encode(test_raw_data, sizeof(test_raw_data), base32_buf, sizeof(base32_buf)) != NULL);
+    test_assert(base32_decode(base32_buf, raw_data_buf, sizeof(raw_data_buf)) == sizeof(test_raw_data));
+    test_assert(memcmp(raw_data_buf, test_raw_data, sizeof(test_raw_data)) == 0);
+
+    /* Z85 */
+    test_assert(strcmp(z85_encode("\x86\x4F\xD2\x6F\xB5\x59\xF7\x5B", 8, base85_buf, sizeof(base85_buf)), "HelloWorld") == 0);
+    test_assert(z85_encode(test_raw_data, 7, base85_buf, sizeof(base85_buf)) == NULL);
+    test_assert(z85_decode("HelloWorld", raw_data_buf, sizeof(raw_data_buf)) == 8 && memcmp(raw_data_buf, "\x86\x4F\xD2\x6F\xB5\x59\xF7\x5B", 8) == 0);
+    test_assert(z85_encode(test_raw_data, sizeof(test_raw_data), base85_buf, sizeof(base85_buf)) != NULL);
+    test_assert(z85_decode(base85_buf, raw_data_buf, sizeof(raw_data_buf)) == sizeof(test_raw_data));
+    test_assert(memcmp(raw_data_buf, test_raw_data, sizeof(test_raw_data)) == 0);
+
+    /* Ascii85 */
+    test_assert(strcmp(ascii85_encode("Man ", 4, base85_buf, sizeof(base85_buf)), "9jqo^") == 0);
+    test_assert(strcmp(ascii85_encode("Man", 3, base85_buf, sizeof(base85_buf)), "9jqo") == 0);
+    test_assert(strcmp(ascii85_encode("\0\0\0\0M", 5, base85_buf, sizeof(base85_buf)), "z9`") == 0);
+    test_assert(ascii85_decode("z9jqo\n^9jqo", raw_data_buf, sizeof(raw_data_buf)) == 11 && memcmp(raw_data_buf, "\0\0\0\0Man Man", 11) == 0);
+    test_assert(ascii85_decode("z9jqo^", raw_data_buf, 7) == -1);
+    test_assert(ascii85_encode(test_raw_data, sizeof(test_raw_data) - 1, base85_buf, sizeof(base85_buf)) != NULL);
+    test_assert(ascii85_decode(base85_buf, raw_data_buf, sizeof(raw_data_buf)) == sizeof(test_raw_data) - 1);
+    test_assert(memcmp(raw_data_buf, test_raw_data, sizeof(test_raw_data) - 1) == 0);
+
     test_assert(base64_decode_image("ata:image/png;base64,iVBORw0KG", "./tmp/test_base64_img.png") == -1);
     test_assert(base64_decode_image("data:image/png; base64,iVBORw0KG", "./tmp/test_base64_img.png") == -1);
     test_assert(base64_decode_image("data:image/ZXCVBNMA;base64,iVBORw0KG", "./tmp/test_base64_img.png") == -1);
     test_assert(base64_decode_image(test_base64_img, "./tmp/test_base64_img.png") == 0);
 
+    img_buf = strdup(test_base64_img);
+    test_assert(img_buf != NULL);
+    test_assert(base64_decode_image_inplace(img_buf, "./tmp/test_base64_img_inplace.png") == 0);
+    free(img_buf);
+
+    /* 解码缓存 */
+    remove("./tmp/base64_cache.idx");
+    remove("./tmp/test_base64_img_c1.png");
+    remove("./tmp/test_base64_img_c2.png");
+    test_assert(base64_cache_init(1, "./tmp/base64_cache.idx", 0) == 0);
+    test_assert(base64_decode_image(test_base64_img, "./tmp/test_base64_img_c1.png") == 0);
+    test_assert(base64_decode_image(test_base64_img, "./tmp/test_base64_img_c2.png") == 0);
+    test_assert(file_equal("./tmp/test_base64_img.png", "./tmp/test_base64_img_c2.png"));
+    test_assert(base64_decode_image(test_base64_img, "./tmp/test_base64_img_c2.png") == 0);
+    base64_cache_get_stats(&cache_stats);
+    test_assert(cache_stats.hits == 2 && cache_stats.misses == 1 && cache_stats.entries == 1 && cache_stats.unchanged == 1);
+    base64_cache_deinit();
+
+    test_assert(base64_cache_init(1, "./tmp/base64_cache.idx", 0) == 0);
+    test_assert(base64_decode_image(test_base64_img, "./tmp/test_base64_img_c3.png") == 0);
+    base64_cache_get_stats(&cache_stats);
+    test_assert(cache_stats.hits == 1 && cache_stats.misses == 0);
+    test_assert(file_equal("./tmp/test_base64_img.png", "./tmp/test_base64_img_c3.png"));
+    test_assert(base64_decode_image("data:image/png;base64,iVBORw0KGgo=", "./tmp/test_base64_img_c4.png") == 0);
+    base64_cache_get_stats(&cache_stats);
+    test_assert(cache_stats.misses == 1 && cache_stats.evictions == 1);
+    test_assert(base64_decode_image("data:image/png;base64,iVBORw0KGgo=", "./tmp/test_base64_img_c1.png") == 0);
+    test_assert(file_equal("./tmp/test_base64_img_c1.png", "./tmp/test_base64_img_c4.png"));
+    test_assert(file_equal("./tmp/test_base64_img.png", "./tmp/test_base64_img_c2.png"));
+    base64_cache_get_stats(&cache_stats);
+    test_assert(cache_stats.hits == 2);
+    base64_cache_deinit();
+
+    /* 索引保存绝对路径，从其他工作目录加载后仍然有效 */
+    test_assert(chdir("./tmp") == 0);
+    test_assert(base64_cache_init(1, "./base64_cache.idx", 0) == 0);
+    test_assert(base64_decode_image("data:image/png;base64,iVBORw0KGgo=", "./test_base64_img_c5.png") == 0);
+    base64_cache_get_stats(&cache_stats);
+    test_assert(cache_stats.hits == 1 && cache_stats.misses == 0);
+    base64_cache_deinit();
+    test_assert(chdir("..") == 0);
+    test_assert(file_equal("./tmp/test_base64_img_c4.png", "./tmp/test_base64_img_c5.png"));
+
+    /* hardlink须显式允许，之后即使未启用缓存，写入同一路径也不会改变共享inode的其他文件 */
+    remove("./tmp/base64_cache.idx");
+    test_assert(base64_cache_init(1, NULL, BASE64_CACHE_FLAG_HARDLINK) == 0);
+    test_assert(base64_decode_image(test_base64_img, "./tmp/test_base64_img_h1.png") == 0);
+    test_assert(base64_decode_image(test_base64_img, "./tmp/test_base64_img_h2.png") == 0);
+    base64_cache_get_stats(&cache_stats);
+    test_assert(cache_stats.hits == 1);
+    base64_cache_deinit();
+    test_assert(base64_decode_image("data:image/png;base64,iVBORw0KGgo=", "./tmp/test_base64_img_h2.png") == 0);
+    test_assert(file_equal("./tmp/test_base64_img.png", "./tmp/test_base64_img_h1.png"));
+    test_assert(file_equal("./tmp/test_base64_img_c4.png", "./tmp/test_base64_img_h2.png"));
+
+    /* 未启用缓存时直接写入，符号链接仍指向原文件 */
+    remove("./tmp/test_base64_img_link.png");
+    test_assert(symlink("test_base64_img_h2.png", "./tmp/test_base64_img_link.png") == 0);
+    test_assert(base64_decode_image(test_base64_img, "./tmp/test_base64_img_link.png") == 0);
+    test_assert(lstat("./tmp/test_base64_img_link.png", &file_stat) == 0 && S_ISLNK(file_stat.st_mode));
+    test_assert(file_equal("./tmp/test_base64_img.png", "./tmp/test_base64_img_h2.png"));
+
+    /* 大数据量编解码，附带计数器报告 */
+    {
+        const size_t text_size = calc_base16_buf_size(TEST_PERF_DATA_SIZE);
+        uint8_t *raw = malloc(TEST_PERF_DATA_SIZE);
+        uint8_t *out = malloc(TEST_PERF_DATA_SIZE);
+        char *text = malloc(text_size);
+        uint32_t seed = 0x12345678;
+        size_t text_len;
+        size_t i;
+
+        test_assert(raw != NULL && out != NULL && text != NULL);
+        for (i = 0; i < TEST_PERF_DATA_SIZE; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            raw[i] = (uint8_t)(seed >> 16);
+        }
+
+        perf_test_assert(&pc, TEST_PERF_DATA_SIZE, base64_encode(raw, TEST_PERF_DATA_SIZE, text, text_size) != NULL);
+        text_len = strlen(text);
+        perf_test_assert(&pc, text_len, base64_decode(text, out, TEST_PERF_DATA_SIZE) == TEST_PERF_DATA_SIZE);
+        test_assert(memcmp(out, raw, TEST_PERF_DATA_SIZE) == 0);
+        perf_test_assert(&pc, text_len, base64_decode_inplace(text, text_size) == TEST_PERF_DATA_SIZE);
+        test_assert(memcmp(text, raw, TEST_PERF_DATA_SIZE) == 0);
+
+        perf_test_assert(&pc, TEST_PERF_DATA_SIZE, base16_encode(raw, TEST_PERF_DATA_SIZE, text, text_size) != NULL);
+        perf_test_assert(&pc, strlen(text), base16_decode(text, out, TEST_PERF_DATA_SIZE) == TEST_PERF_DATA_SIZE);
+        test_assert(memcmp(out, raw, TEST_PERF_DATA_SIZE) == 0);
+
+        perf_test_assert(&pc, TEST_PERF_DATA_SIZE, base32_encode(raw, TEST_PERF_DATA_SIZE, text, text_size) != NULL);
+        perf_test_assert(&pc, strlen(text), base32_decode(text, out, TEST_PERF_DATA_SIZE) == TEST_PERF_DATA_SIZE);
+        test_assert(memcmp(out, raw, TEST_PERF_DATA_SIZE) == 0);
+
+        perf_test_assert(&pc, TEST_PERF_DATA_SIZE, z85_encode(raw, TEST_PERF_DATA_SIZE, text, text_size) != NULL);
+        perf_test_assert(&pc, strlen(text), z85_decode(text, out, TEST_PERF_DATA_SIZE) == TEST_PERF_DATA_SIZE);
+        test_assert(memcmp(out, raw, TEST_PERF_DATA_SIZE) == 0);
+
+        perf_test_assert(&pc, TEST_PERF_DATA_SIZE, ascii85_encode(raw, TEST_PERF_DATA_SIZE, text, text_size) != NULL);
+        perf_test_assert(&pc, strlen(text), ascii85_decode(text, out, TEST_PERF_DATA_SIZE) == TEST_PERF_DATA_SIZE);
+        test_assert(memcmp(out, raw, TEST_PERF_DATA_SIZE) == 0);
+
+        free(raw);
+        free(out);
+        free(text);
+    }
+
+    perf_counter_close(&pc);
+
     return 0;
 }
@@ -0,0 +1,214 @@
+/**
+ * Copyright (c) 2021-2026, Haier
+ *
+ * unit test for log ring.
+ *
+ * Change Logs:
+ * Date             Author              Notes
+ * 2026-10-19       agent               first version
+ */
+
+#define LOG_TAG             "Test"
+#define LOG_LVL             LOG_LVL_DEBUG
+#define LOG_RING_ENABLE
+
+#include "log_ring.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include "log.h"
+
+#define TEST_LOG_RING_PATH          "./tmp/test_log_ring.bin"
+
+/* 并发测试：线程数及每个线程写入的行数 */
+#define TEST_THREAD_NUM             4
+#define TEST_THREAD_LINES           200
+
+static char dump_buf[64 * 1024];
+
+/**
+ * @brief 导出环形日志文件到dump_buf
+ *
+ * @return 成功返回导出的日志条数，失败返回<0
+ */
+static int dump_log_ring(void)
+{
+    FILE *fp = fmemopen(dump_buf, sizeof(dump_buf), "w");
+    int count;
+
+    if (fp == NULL)
+        return -1;
+    count = log_ring_dump(TEST_LOG_RING_PATH, fp);
+    fputc('\0', fp);
+    fclose(fp);
+
+    return count;
+}
+
+/**
+ * @brief 检查dump_buf中的"line %d\n"是否从first开始连续递增到last
+ */
+static int lines_consecutive(int first, int last)
+{
+    const char *p = dump_buf;
+    int expect = first;
+    int n;
+
+    while (sscanf(p, "line %d\n", &n) == 1)
+    {
+        if (n != expect)
+            return 0;
+        expect++;
+        p = strchr(p, '\n') + 1;
+    }
+
+    return expect == last + 1 && *p == '\0';
+}
+
+/**
+ * @brief 并发写日志的线程
+ */
+static void *log_thread(void *arg)
+{
+    int id = (int)(intptr_t)arg;
+    int i;
+
+    for (i = 0; i < TEST_THREAD_LINES; i++)
+        log_i("thread %d line %d", id, i);
+
+    return NULL;
+}
+
+/**
+ * @brief 检查dump_buf中每行都是完整的log_i()输出，且各线程的行按顺序出现
+ *
+ * @return 完整的行数，发现残缺或乱序的行时返回<0
+ */
+static int lines_intact(void)
+{
+    int next[TEST_THREAD_NUM] = { 0 };
+    const char *p = dump_buf;
+    const char *body;
+    int count = 0;
+    int id, n;
+
+    while (*p != '\0')
+    {
+        body = strstr(p, "[func:log_thread] ");
+        if (strncmp(p, "[I] [Test] [", 12) != 0 || body == NULL || body > strchr(p, '\n'))
+            return -1;
+        if (sscanf(body, "[func:log_thread] thread %d line %d\n", &id, &n) != 2
+            || id < 0 || id >= TEST_THREAD_NUM || n != next[id]++)
+            return -1;
+        p = strchr(p, '\n') + 1;
+        count++;
+    }
+
+    return count;
+}
+
+int main(int argc, char *argv[])
+{
+    char line[32];
+    int ret[3];
+    int len;
+    int i;
+
+    /* 未打开时输出到stdout */
+    test_assert(log_ring_write(LOG_LVL_INFO, "x", 1) < 0);
+    test_assert(log_ring_dump("./tmp/not_exist.bin", stdout) < 0);
+
+    /* 按写入顺序导出（打开期间test_assert也会写入环形日志文件，关闭后再检查结果） */
+    ret[0] = log_ring_open(TEST_LOG_RING_PATH, 4096, LOG_RING_FLAG_TRUNCATE);
+    ret[1] = log_ring_write(LOG_LVL_INFO, "line 0\n", 7);
+    ret[2] = log_ring_printf(LOG_LVL_INFO, "line %d\n", 1);
+    log_ring_close();
+    test_assert(ret[0] == 0 && ret[1] == 7 && ret[2] == 7);
+    test_assert(dump_log_ring() == 2);
+    test_assert(strcmp(dump_buf, "line 0\nline 1\n") == 0);
+
+    /* 写满后覆盖最旧的日志 */
+    ret[0] = log_ring_open(TEST_LOG_RING_PATH, 1024, LOG_RING_FLAG_TRUNCATE);
+    for (i = 0; i < 1000; i++)
+    {
+        len = snprintf(line, sizeof(line), "line %d\n", i);
+        log_ring_write(LOG_LVL_INFO, line, len);
+    }
+    log_ring_close();
+    test_assert(ret[0] == 0);
+    test_assert(dump_log_ring() > 0);
+    test_assert(strncmp(dump_buf, "line 0\n", 7) != 0);
+    test_assert(lines_consecutive(atoi(dump_buf + 5), 999));
+
+    /* 重新打开后接着追加 */
+    ret[0] = log_ring_open(TEST_LOG_RING_PATH, 1024, 0);
+    ret[1] = log_ring_write(LOG_LVL_INFO, "line 1000\n", 10);
+    log_ring_close();
+    test_assert(ret[0] == 0 && ret[1] == 10);
+    test_assert(dump_log_ring() > 0);
+    test_assert(lines_consecutive(atoi(dump_buf + 5), 1000));
+
+    /* 超长日志截断 */
+    memset(dump_buf, 'a', 1000);
+    ret[0] = log_ring_open(TEST_LOG_RING_PATH, 256, LOG_RING_FLAG_TRUNCATE);
+    ret[1] = log_ring_write(LOG_LVL_INFO, dump_buf, 1000);
+    log_ring_close();
+    test_assert(ret[0] == 0 && ret[1] == 256 / 2 - 8);
+    test_assert(dump_log_ring() == 1);
+    test_assert(strlen(dump_buf) == 256 / 2 - 8);
+
+    /* log.h日志经log_printf写入，进程崩溃后日志仍在 */
+    if (fork() == 0)
+    {
+        log_ring_open(TEST_LOG_RING_PATH, 4096, LOG_RING_FLAG_TRUNCATE);
+        log_i("before crash %d", 42);
+        abort();
+    }
+    wait(NULL);
+    test_assert(dump_log_ring() == 1);
+    test_assert(strncmp(dump_buf, "[I] [Test] [", 12) == 0 && strstr(dump_buf, "before crash 42\n") != NULL);
+    test_assert(strchr(dump_buf, '\033') == NULL);
+
+    /* 以不同容量重新打开时沿用文件中的容量，崩溃前的日志不丢失 */
+    ret[0] = log_ring_open(TEST_LOG_RING_PATH, 8192, 0);
+    log_ring_close();
+    test_assert(ret[0] == 0);
+    test_assert(dump_log_ring() == 1 && strstr(dump_buf, "before crash 42\n") != NULL);
+
+    /* 无法识别的文件改名保留 */
+    {
+        FILE *fp = fopen(TEST_LOG_RING_PATH, "wb");
+
+        remove(TEST_LOG_RING_PATH ".old");
+        test_assert(fp != NULL && fputs("not a log ring", fp) >= 0 && fclose(fp) == 0);
+        ret[0] = log_ring_open(TEST_LOG_RING_PATH, 4096, 0);
+        ret[1] = log_ring_write(LOG_LVL_INFO, "line 0\n", 7);
+        log_ring_close();
+        test_assert(ret[0] == 0 && ret[1] == 7);
+        test_assert(dump_log_ring() == 1 && strcmp(dump_buf, "line 0\n") == 0);
+        fp = fopen(TEST_LOG_RING_PATH ".old", "rb");
+        test_assert(fp != NULL && fgets(line, sizeof(line), fp) != NULL && strcmp(line, "not a log ring") == 0);
+        if (fp != NULL)
+            fclose(fp);
+    }
+
+    /* 多线程并发写入，每行日志对应一条完整记录 */
+    {
+        pthread_t threads[TEST_THREAD_NUM];
+
+        ret[0] = log_ring_open(TEST_LOG_RING_PATH, sizeof(dump_buf) * 2, LOG_RING_FLAG_TRUNCATE);
+        for (i = 0; i < TEST_THREAD_NUM; i++)
+            pthread_create(&threads[i], NULL, log_thread, (void *)(intptr_t)i);
+        for (i = 0; i < TEST_THREAD_NUM; i++)
+            pthread_join(threads[i], NULL);
+        log_ring_close();
+        test_assert(ret[0] == 0);
+        test_assert(dump_log_ring() == TEST_THREAD_NUM * TEST_THREAD_LINES);
+        test_assert(lines_intact() == TEST_THREAD_NUM * TEST_THREAD_LINES);
+    }
+
+    return 0;
+}